@@ -0,0 +1,122 @@
+// AoS against SoA state layout for the passes of EulerFVWENO5::op_L.
+//
+// For each number of cells n the report gives ns per cell of the
+// component-wise and the characteristic reconstruction, the HLLC and Rusanov
+// Riemann solves and the whole op_L, in both layouts, and the ratio
+// AoS / SoA (> 1: SoA is faster).
+//
+// usage: bench_euler_layout [--sizes 1024,16384,262144] [--reps 5]
+//                           [--out file.csv]
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench_utils.hpp"
+
+#include "euler.hpp"
+#include "schemes/euler_fv_weno5.hpp"
+#include "system_vec.hpp"
+
+using namespace flux;  // NOLINT
+
+template <Layout L>
+SystemVec<3, L> sample_state(std::size_t n) {
+    auto u = SystemVec<3, L>(std::vector<double>(3 * n));
+    for (std::size_t i = 0; i < n; i++) {
+        double x = 0.37 * static_cast<double>(i);
+        u.set(i, euler::conserved({1 + 0.2 * std::sin(x), 0.5 * std::sin(x),
+                                   1 + 0.1 * std::cos(x)}));
+    }
+    return u;
+}
+
+// seconds per call of every pass for layout L
+template <Layout L>
+std::vector<bench::Stats> measure_layout(std::size_t n, std::size_t reps) {
+    using V = SystemVec<3, L>;
+    using HLLCScheme = schemes::EulerFVWENO5<L, euler::HLLC>;
+    using RusanovScheme = schemes::EulerFVWENO5<L, euler::Rusanov>;
+
+    auto var = sample_state<L>(n);
+    auto u = pad_periodic(var, HLLCScheme::halo);
+    auto ul = V(std::vector<double>(3 * (n + 2)));
+    auto ur = V(std::vector<double>(3 * (n + 2)));
+    auto F = V(std::vector<double>(3 * (n + 1)));
+    auto ex = Mesh1d{1.0 / static_cast<double>(n)};
+    auto scheme = HLLCScheme{};
+
+    auto run = [&](auto &&func) {
+        return bench::summarize(bench::measure(func, 1, reps));
+    };
+
+    std::vector<bench::Stats> result;
+    result.push_back(run([&]() {
+        HLLCScheme::reconstruct_conserved(u, ul, ur);
+        bench::keep(ul.data[n]);
+    }));
+    result.push_back(run([&]() {
+        HLLCScheme::reconstruct_characteristic(u, ul, ur);
+        bench::keep(ul.data[n]);
+    }));
+    result.push_back(run([&]() {
+        HLLCScheme::riemann(ul, ur, F);
+        bench::keep(F.data[n]);
+    }));
+    result.push_back(run([&]() {
+        RusanovScheme::riemann(ul, ur, F);
+        bench::keep(F.data[n]);
+    }));
+    result.push_back(run([&]() {
+        auto L_var = scheme.op_L(var, ex, 0);
+        bench::keep(L_var.data[n]);
+    }));
+    return result;
+}
+
+int main(int argc, char **argv) {
+    auto args = bench::Args(argc, argv);
+    auto sizes =
+        args.get("--sizes", std::vector<std::size_t>{1024, 16384, 262144});
+    auto reps = args.get("--reps", std::size_t{5});
+    auto out =
+        args.get("--out", std::string{OUTPUT_DIR "/bench_euler_layout.csv"});
+
+    std::fstream f(out, std::ios::out);
+    if (f.fail()) {
+        std::cerr << "bench_euler_layout: fail to open file " << out
+                  << std::endl;
+        exit(1);
+    }
+    f << "pass,n,aos_ns_per_cell,aos_ci95,soa_ns_per_cell,soa_ci95,ratio\n";
+
+    const char *passes[] = {"reconstruct", "reconstruct_char", "riemann_hllc",
+                            "riemann_rusanov", "op_L"};
+
+    std::printf("%-17s %8s %10s %10s %10s %10s %7s\n", "pass", "n", "AoS ns",
+                "ci95", "SoA ns", "ci95", "AoS/SoA");
+
+    for (auto n : sizes) {
+        auto aos = measure_layout<Layout::AoS>(n, reps);
+        auto soa = measure_layout<Layout::SoA>(n, reps);
+        auto cells = static_cast<double>(n);
+
+        for (std::size_t k = 0; k < std::size(passes); k++) {
+            double a = aos[k].median / cells * 1e9;
+            double a_ci = aos[k].ci95 / cells * 1e9;
+            double s = soa[k].median / cells * 1e9;
+            double s_ci = soa[k].ci95 / cells * 1e9;
+            std::printf("%-17s %8zu %10.3f %10.3f %10.3f %10.3f %7.2f\n",
+                        passes[k], n, a, a_ci, s, s_ci, a / s);
+            f << passes[k] << ',' << n << ',' << a << ',' << a_ci << ',' << s
+              << ',' << s_ci << ',' << a / s << '\n';
+        }
+        std::printf("\n");
+    }
+
+    std::cout << "export to file " << out << '\n';
+    return 0;
+}
@@ -0,0 +1,423 @@
+// Throughput of the numerical building blocks in isolation.
+//
+// Each kernel is swept over arrays from L1-resident to DRAM-resident sizes.
+// For every case the report gives cells/s, GFLOP/s, GB/s of compulsory
+// traffic and the arithmetic intensity, together with a roofline bound
+// min(peak GFLOP/s, AI * GB/s) built from measured ceilings: a multiply-add
+// loop with independent accumulators, and a STREAM-like triad run at the same
+// array length as the kernel so the bandwidth ceiling matches its cache level.
+//
+// Flop counts are per cell and counted by hand from the source; transcendental
+// functions (BurgersExact) count as one flop each.
+//
+// usage: bench_kernels [--min-log2 10] [--max-log2 24] [--reps 5]
+//                      [--out file.csv]
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+#include "bench_utils.hpp"
+
+#include "burgers_exact.hpp"
+#include "legendre_polys.hpp"
+#include "limiter.hpp"
+#include "flux_policy.hpp"
+#include "numerical_flux.hpp"
+#include "projection.hpp"
+#include "schemes/fv_weno5.hpp"
+#include "weno.hpp"
+#include "weno5.hpp"
+
+using namespace flux;  // NOLINT
+
+struct Kernel {
+    std::string name;
+    double flop_per_cell;
+    double bytes_per_cell;  // compulsory traffic
+    std::size_t arrays;     // doubles per cell held in memory
+    std::function<std::function<void()>(std::size_t n)> setup;
+};
+
+inline std::vector<double> sample_data(std::size_t n, double phase) {
+    std::vector<double> v(n);
+    for (std::size_t i = 0; i < n; i++) {
+        v[i] = 0.5 + std::sin(0.37 * static_cast<double>(i) + phase);
+    }
+    return v;
+}
+
+// c[i] = fhat(a[i], b[i])
+template <typename Flux>
+Kernel flux_kernel(const std::string &name, double flop_per_cell, Flux fhat) {
+    return {name, flop_per_cell, 24, 3, [fhat](std::size_t n) {
+                auto a = std::make_shared<std::vector<double>>(
+                    sample_data(n, 0));
+                auto b = std::make_shared<std::vector<double>>(
+                    sample_data(n, 1));
+                auto c = std::make_shared<std::vector<double>>(n);
+                return [a, b, c, n, fhat]() {
+                    for (std::size_t i = 0; i < n; i++) {
+                        (*c)[i] = fhat((*a)[i], (*b)[i]);
+                    }
+                    bench::keep((*c)[n / 2]);
+                };
+            }};
+}
+
+// weno5 with the weights W
+template <WenoWeights W>
+Kernel weno5_kernel(const std::string &name, double flop_per_cell) {
+    return {name, flop_per_cell, 24, 4, [](std::size_t n) {
+                auto u = std::make_shared<std::vector<double>>(
+                    sample_data(n, 0));
+                auto ul = std::make_shared<std::vector<double>>(n);
+                auto ur = std::make_shared<std::vector<double>>(n);
+                return [u, ul, ur]() {
+                    weno5<W>(*u, *ul, *ur);
+                    bench::keep((*ul)[0] + (*ur)[0]);
+                };
+            }};
+}
+
+// generated WENO of order 2R - 1 (weno.hpp)
+template <std::size_t R>
+Kernel weno_kernel(const std::string &name, double flop_per_cell) {
+    return {name, flop_per_cell, 24, 4, [](std::size_t n) {
+                auto u = std::make_shared<std::vector<double>>(
+                    sample_data(n, 0));
+                auto ul = std::make_shared<std::vector<double>>(n);
+                auto ur = std::make_shared<std::vector<double>>(n);
+                return [u, ul, ur]() {
+                    weno<R>(*u, *ul, *ur);
+                    bench::keep((*ul)[0] + (*ur)[0]);
+                };
+            }};
+}
+
+std::vector<Kernel> kernels() {
+    constexpr std::size_t DG_k = 2;
+    std::vector<Kernel> result;
+
+    result.push_back({"weno5", 119, 24, 4, [](std::size_t n) {
+                          auto u = std::make_shared<std::vector<double>>(
+                              sample_data(n, 0));
+                          auto ul = std::make_shared<std::vector<double>>(n);
+                          auto ur = std::make_shared<std::vector<double>>(n);
+                          return [u, ul, ur]() {
+                              weno5(*u, *ul, *ur);
+                              bench::keep((*ul)[0] + (*ur)[0]);
+                          };
+                      }});
+
+    // other nonlinear weights (weno_weights.hpp)
+    result.push_back(weno5_kernel<WenoZ>("weno5<Z>", 135));
+    result.push_back(weno5_kernel<WenoM>("weno5<M>", 191));
+
+    // generated tables, weno<3> is weno5 up to rounding
+    result.push_back(weno_kernel<3>("weno<3>", 119));
+    result.push_back(weno_kernel<4>("weno<4>", 210));
+    result.push_back(weno_kernel<5>("weno<5>", 338));
+
+    // single precision: half the traffic, twice the SIMD lanes
+    result.push_back({"weno5<float>", 119, 12, 4, [](std::size_t n) {
+                          auto v = sample_data(n, 0);
+                          auto u = std::make_shared<std::vector<float>>(
+                              v.begin(), v.end());
+                          auto ul = std::make_shared<std::vector<float>>(n);
+                          auto ur = std::make_shared<std::vector<float>>(n);
+                          return [u, ul, ur]() {
+                              weno5(*u, *ul, *ur);
+                              bench::keep((*ul)[0] + (*ur)[0]);
+                          };
+                      }});
+
+    result.push_back({"fhat_godunov", 6, 24, 3, [](std::size_t n) {
+                          auto a = std::make_shared<std::vector<double>>(
+                              sample_data(n, 0));
+                          auto b = std::make_shared<std::vector<double>>(
+                              sample_data(n, 1));
+                          auto c = std::make_shared<std::vector<double>>(n);
+                          return [a, b, c, n]() {
+                              for (std::size_t i = 0; i < n; i++) {
+                                  (*c)[i] = fhat_godunov((*a)[i], (*b)[i]);
+                              }
+                              bench::keep((*c)[n / 2]);
+                          };
+                      }});
+
+    result.push_back({"fhat_LF", 13, 24, 3, [](std::size_t n) {
+                          auto a = std::make_shared<std::vector<double>>(
+                              sample_data(n, 0));
+                          auto b = std::make_shared<std::vector<double>>(
+                              sample_data(n, 1));
+                          auto c = std::make_shared<std::vector<double>>(n);
+                          return [a, b, c, n]() {
+                              for (std::size_t i = 0; i < n; i++) {
+                                  (*c)[i] = fhat_LF((*a)[i], (*b)[i]);
+                              }
+                              bench::keep((*c)[n / 2]);
+                          };
+                      }});
+
+    // weno5 + fhat_LF + update in one pass over tiles (schemes/fv_weno5.hpp),
+    // compulsory traffic u and L only
+    result.push_back({"FVWENO5::op_L", 134, 16, 2, [](std::size_t n) {
+                          auto u = std::make_shared<std::vector<double>>(
+                              pad_periodic(sample_data(n, 0), 3, 1));
+                          auto L = std::make_shared<std::vector<double>>(n);
+                          return [u, L, n]() {
+                              schemes::FVWENO5{}.op_L(*u, 0, Mesh1d{1e-3}, *L,
+                                                      0, n);
+                              bench::keep((*L)[n / 2]);
+                          };
+                      }});
+
+    // the same fluxes for other scalar laws (flux_policy.hpp)
+    using LA = LinearAdvection<>;
+    using BL = BuckleyLeverett<>;
+    result.push_back(flux_kernel("fhat_godunov<LA>", 2, [](auto l, auto r) {
+        return fhat_godunov<LA>(l, r);
+    }));
+    result.push_back(flux_kernel("fhat_LF<LA>", 8, [](auto l, auto r) {
+        return fhat_LF<LA>(l, r);
+    }));
+    result.push_back(flux_kernel("fhat_godunov<BL>", 22, [](auto l, auto r) {
+        return fhat_godunov<BL>(l, r);
+    }));
+    result.push_back(flux_kernel("fhat_LF<BL>", 46, [](auto l, auto r) {
+        return fhat_LF<BL>(l, r);
+    }));
+
+    result.push_back({"Limiter::minmod", 12, 40, 5, [](std::size_t n) {
+                          auto ul = std::make_shared<std::vector<double>>(
+                              sample_data(n, 0));
+                          auto ur = std::make_shared<std::vector<double>>(
+                              sample_data(n, 1));
+                          auto mean = std::make_shared<std::vector<double>>(
+                              sample_data(n, 2));
+                          auto out_l = std::make_shared<std::vector<double>>(n);
+                          auto out_r = std::make_shared<std::vector<double>>(n);
+                          return [=]() {
+                              auto limiter = Limiter{1e-3};
+                              const auto &m = *mean;
+                              for (std::size_t i = 1; i + 1 < n; i++) {
+                                  double l = (*ul)[i];
+                                  double r = (*ur)[i];
+                                  limiter.minmod(l, r, m[i - 1], m[i], m[i + 1]);
+                                  (*out_l)[i] = l;
+                                  (*out_r)[i] = r;
+                              }
+                              bench::keep((*out_l)[n / 2] + (*out_r)[n / 2]);
+                          };
+                      }});
+
+    result.push_back(
+        {"Limiter::DG_recover", 6, 24 + 8 * (DG_k + 1), 3 + DG_k + 1,
+         [](std::size_t n) {
+             auto mean = std::make_shared<std::vector<double>>(sample_data(n, 0));
+             auto left = std::make_shared<std::vector<double>>(sample_data(n, 1));
+             auto right = std::make_shared<std::vector<double>>(sample_data(n, 2));
+             auto u = std::make_shared<std::vector<double>>(n * (DG_k + 1));
+             return [=]() {
+                 for (std::size_t i = 0; i < n; i++) {
+                     Limiter::DG_recover(*u, i * (DG_k + 1), DG_k, (*mean)[i],
+                                         (*left)[i], (*right)[i]);
+                 }
+                 bench::keep((*u)[n / 2]);
+             };
+         }});
+
+    result.push_back(
+        {"evals<LegendrePolys>", 10, 8 * (DG_k + 1) + 8, DG_k + 2,
+         [](std::size_t n) {
+             auto u = std::make_shared<std::vector<double>>(
+                 sample_data(n * (DG_k + 1), 0));
+             auto out = std::make_shared<std::vector<double>>(n);
+             return [=]() {
+                 for (std::size_t i = 0; i < n; i++) {
+                     (*out)[i] =
+                         evals<LegendrePolys>(*u, 0.3, i * (DG_k + 1), DG_k + 1);
+                 }
+                 bench::keep((*out)[n / 2]);
+             };
+         }});
+
+    // projections of u0 = 0.5 + sin(x) at gauss_k = 5 (projection.hpp),
+    // serial like the other kernels
+    auto init = [](double x) { return 0.5 + std::sin(x); };
+    result.push_back({"cell_averages", 25, 16, 2, [init](std::size_t n) {
+                          auto x = std::make_shared<std::vector<double>>(
+                              sample_data(n, 0));
+                          return [x, init]() {
+                              auto u = cell_averages(init, *x, 1e-3, 5, 1);
+                              bench::keep(u[u.size() / 2]);
+                          };
+                      }});
+
+    result.push_back(
+        {"modal_projection", 15 + 10 * (DG_k + 1), 8 + 8 * (DG_k + 1),
+         DG_k + 2, [init](std::size_t n) {
+             auto x = std::make_shared<std::vector<double>>(sample_data(n, 0));
+             return [x, init]() {
+                 auto u = modal_projection(init, *x, 1e-3, DG_k, 5, 1);
+                 bench::keep(u[u.size() / 2]);
+             };
+         }});
+
+    result.push_back({"BurgersExact::eval", 50, 16, 2, [](std::size_t n) {
+                          auto x = std::make_shared<std::vector<double>>(n);
+                          for (std::size_t i = 0; i < n; i++) {
+                              (*x)[i] = -3.14 + 6.28 * static_cast<double>(i)
+                                                    / static_cast<double>(n);
+                          }
+                          auto out = std::make_shared<std::vector<double>>(n);
+                          return [x, out, n]() {
+                              auto exact = BurgersExact(0.5, 1.0, 1.0, 0, 1e-10);
+                              for (std::size_t i = 0; i < n; i++) {
+                                  (*out)[i] = exact.eval((*x)[i], 0.5);
+                              }
+                              bench::keep((*out)[n / 2]);
+                          };
+                      }});
+
+    return result;
+}
+
+// peak floating point rate of this build: independent multiply-add chains,
+// few enough to stay in registers
+double measure_peak_gflops() {
+    constexpr std::size_t lanes = 32;
+    constexpr std::size_t iters = 1 << 20;
+
+    auto samples = bench::measure(
+        [&]() {
+            static volatile double va = 0.999999;
+            static volatile double vb = 1e-7;
+            const double a = va;
+            const double b = vb;
+
+            double acc[lanes];
+            for (auto &v : acc) v = 1.0;
+            for (std::size_t it = 0; it < iters; it++) {
+                for (std::size_t k = 0; k < lanes; k++) acc[k] = acc[k] * a + b;
+            }
+
+            double sum = 0;
+            for (auto v : acc) sum += v;
+            bench::keep(sum);
+        },
+        1, 5);
+    auto best = bench::summarize(samples).min;
+    return 2.0 * lanes * iters / best / 1e9;
+}
+
+// memory bandwidth of a = b + s * c with arrays of length n
+double measure_peak_gbs(std::size_t n) {
+    std::vector<double> a(n, 0.0);
+    std::vector<double> b(n, 1.0);
+    std::vector<double> c(n, 2.0);
+
+    auto samples = bench::measure(
+        [&]() {
+            for (std::size_t i = 0; i < n; i++) a[i] = b[i] + 0.5 * c[i];
+            bench::keep(a[n / 2]);
+        },
+        1, 5);
+    auto best = bench::summarize(samples).min;
+    return 24.0 * static_cast<double>(n) / best / 1e9;
+}
+
+std::string memory_level(std::size_t bytes) {
+#if defined(__linux__) && defined(_SC_LEVEL1_DCACHE_SIZE)
+    const auto l1 = sysconf(_SC_LEVEL1_DCACHE_SIZE);
+    const auto l2 = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    const auto l3 = sysconf(_SC_LEVEL3_CACHE_SIZE);
+    const auto b = static_cast<long>(bytes);
+    if (l1 > 0 && b <= l1) return "L1";
+    if (l2 > 0 && b <= l2) return "L2";
+    if (l3 > 0 && b <= l3) return "L3";
+    if (l1 > 0) return "DRAM";
+#endif
+    return "?";
+}
+
+int main(int argc, char **argv) {
+    auto args = bench::Args(argc, argv);
+    auto min_log2 = args.get("--min-log2", std::size_t{10});
+    auto max_log2 = args.get("--max-log2", std::size_t{24});
+    auto reps = args.get("--reps", std::size_t{5});
+    auto out = args.get("--out", std::string{OUTPUT_DIR "/bench_kernels.csv"});
+
+    auto peak_gflops = measure_peak_gflops();
+    std::printf("ceiling: %.2f GFLOP/s (mul+add)\n", peak_gflops);
+
+    auto peak_gbs = std::map<std::size_t, double>{};
+    for (std::size_t p = min_log2; p <= max_log2; p += 2) {
+        std::size_t n = std::size_t{1} << p;
+        peak_gbs[n] = measure_peak_gbs(n);
+        std::printf("ceiling: %.2f GB/s (triad, n = %zu, %s)\n", peak_gbs[n],
+                    n, memory_level(3 * n * sizeof(double)).c_str());
+    }
+    std::printf("\n");
+
+    std::fstream f(out, std::ios::out);
+    if (f.fail()) {
+        std::cerr << "bench_kernels: fail to open file " << out << std::endl;
+        exit(1);
+    }
+    f << "kernel,n,working_set_bytes,level,flop_per_cell,bytes_per_cell,ai,"
+         "cells_per_s,gflops,gbs,roof_gflops,roof_pct\n";
+
+    std::printf("%-22s %10s %5s %10s %9s %8s %6s %9s %6s\n", "kernel", "n",
+                "level", "Mcells/s", "GFLOP/s", "GB/s", "AI", "roof", "%roof");
+
+    for (const auto &kernel : kernels()) {
+        for (std::size_t p = min_log2; p <= max_log2; p += 2) {
+            std::size_t n = std::size_t{1} << p;
+            auto working_set = kernel.arrays * n * sizeof(double);
+
+            auto run = kernel.setup(n);
+
+            // repeat small cases so one sample takes a measurable time
+            std::size_t inner = std::max<std::size_t>(1, (std::size_t{1} << 22) / n);
+            auto samples = bench::measure(
+                [&]() {
+                    for (std::size_t k = 0; k < inner; k++) run();
+                },
+                1, reps);
+            auto seconds = bench::summarize(samples).median
+                           / static_cast<double>(inner);
+
+            double cells_per_s = static_cast<double>(n) / seconds;
+            double gflops = kernel.flop_per_cell * cells_per_s / 1e9;
+            double gbs = kernel.bytes_per_cell * cells_per_s / 1e9;
+            double ai = kernel.flop_per_cell / kernel.bytes_per_cell;
+            double roof = std::min(peak_gflops, ai * peak_gbs[n]);
+            double pct = 100 * gflops / roof;
+            auto level = memory_level(working_set);
+
+            std::printf("%-22s %10zu %5s %10.2f %9.3f %8.2f %6.2f %9.3f %5.1f%%\n",
+                        kernel.name.c_str(), n, level.c_str(), cells_per_s / 1e6,
+                        gflops, gbs, ai, roof, pct);
+            f << kernel.name << ',' << n << ',' << working_set << ',' << level
+              << ',' << kernel.flop_per_cell << ',' << kernel.bytes_per_cell
+              << ',' << ai << ',' << cells_per_s << ',' << gflops << ',' << gbs
+              << ',' << roof << ',' << pct << '\n';
+        }
+        std::printf("\n");
+    }
+
+    std::cout << "export to file " << out << '\n';
+    return 0;
+}
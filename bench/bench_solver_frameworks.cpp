@@ -0,0 +1,365 @@
+// Compare the five time integration frameworks on identical problems.
+//
+// Every framework drives the same scheme object from include/schemes, so the
+// measured difference is the cost of the framework itself (dispatch, copies,
+// type erasure). Results are reported as ns per cell-update, i.e. wall time
+// divided by (cells * time steps).
+//
+// usage: bench_solver_frameworks [--sizes 256,4096,65536] [--steps 10]
+//                                [--reps 7] [--warmup 2] [--out file.csv]
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "bench_utils.hpp"
+
+#include "burgers_exact.hpp"
+#include "constants.hpp"
+#include "legendre_polys.hpp"
+#include "linespace.hpp"
+#include "projection.hpp"
+#include "schemes/dg.hpp"
+#include "schemes/fv_godunov.hpp"
+#include "schemes/fv_weno5.hpp"
+#include "solver/solver_crtp.hpp"
+#include "solver/solver_stdfunc.hpp"
+#include "solver/solver_template.hpp"
+#include "solver/solver_virtual.hpp"
+
+#ifdef HAS_DEDUCING_THIS
+#include "solver/solver_deducing.hpp"
+#endif
+
+
+using namespace flux;  // NOLINT
+
+template <typename Scheme>
+Vec stage_of(const Scheme &scheme, const Vec &var, Mesh1d &ex, double t) {
+    if constexpr (requires { scheme.post_process_rk_stage(var, ex, t); }) {
+        return scheme.post_process_rk_stage(var, ex, t);
+    }
+    else {
+        return var;
+    }
+}
+
+// crtp
+
+template <typename Scheme>
+class CrtpSolver;
+
+template <typename Scheme>
+using CrtpBase =
+    std::conditional_t<Scheme::rk3,
+                       solver_crtp::RK3Solver<Vec, Mesh1d, CrtpSolver<Scheme>>,
+                       solver_crtp::EulerSolver<Vec, Mesh1d, CrtpSolver<Scheme>>>;
+
+template <typename Scheme>
+class CrtpSolver : public CrtpBase<Scheme> {
+public:
+    explicit CrtpSolver(Scheme scheme) : m_scheme(std::move(scheme)) {}
+
+    double get_dt(const Vec &var, Mesh1d &ex, double t) const {
+        return m_scheme.get_dt(var, ex, t);
+    }
+
+    Vec op_L(const Vec &var, Mesh1d &ex, double t) const {
+        return m_scheme.op_L(var, ex, t);
+    }
+
+    Vec post_process_rk_stage(const Vec &var, Mesh1d &ex, double t) const {
+        return stage_of(m_scheme, var, ex, t);
+    }
+
+private:
+    Scheme m_scheme;
+};
+
+// deducing this
+
+#ifdef HAS_DEDUCING_THIS
+template <typename Scheme>
+using DeducingBase =
+    std::conditional_t<Scheme::rk3, solver_deducing::RK3Solver<Vec, Mesh1d>,
+                       solver_deducing::EulerSolver<Vec, Mesh1d>>;
+
+template <typename Scheme>
+class DeducingSolver : public DeducingBase<Scheme> {
+public:
+    explicit DeducingSolver(Scheme scheme) : m_scheme(std::move(scheme)) {}
+
+    double get_dt(const Vec &var, Mesh1d &ex, double t) const {
+        return m_scheme.get_dt(var, ex, t);
+    }
+
+    Vec op_L(const Vec &var, Mesh1d &ex, double t) const {
+        return m_scheme.op_L(var, ex, t);
+    }
+
+    Vec post_process_rk_stage(const Vec &var, Mesh1d &ex, double t) const {
+        return stage_of(m_scheme, var, ex, t);
+    }
+
+private:
+    Scheme m_scheme;
+};
+#endif
+
+// virtual
+
+template <typename Scheme, bool = Scheme::rk3>
+class VirtualSolver : public solver_virtual::EulerSolver<Vec, Mesh1d> {
+public:
+    explicit VirtualSolver(Scheme scheme) : m_scheme(std::move(scheme)) {}
+
+    double get_dt(const Vec &var, Mesh1d &ex, double t) const override {
+        return m_scheme.get_dt(var, ex, t);
+    }
+
+    Vec op_L(const Vec &var, Mesh1d &ex, double t) const override {
+        return m_scheme.op_L(var, ex, t);
+    }
+
+private:
+    Scheme m_scheme;
+};
+
+template <typename Scheme>
+class VirtualSolver<Scheme, true> : public solver_virtual::RK3Solver<Vec, Mesh1d> {
+public:
+    explicit VirtualSolver(Scheme scheme) : m_scheme(std::move(scheme)) {}
+
+    double get_dt(const Vec &var, Mesh1d &ex, double t) const override {
+        return m_scheme.get_dt(var, ex, t);
+    }
+
+    Vec op_L(const Vec &var, Mesh1d &ex, double t) const override {
+        return m_scheme.op_L(var, ex, t);
+    }
+
+    Vec post_process_rk_stage(const Vec &var, Mesh1d &ex,
+                              double t) const override {
+        return stage_of(m_scheme, var, ex, t);
+    }
+
+private:
+    Scheme m_scheme;
+};
+
+// std::function
+
+template <typename Scheme>
+auto make_stdfunc_solver(const Scheme &scheme) {
+    using Factory = solver_stdfunc::UpdaterFactory<Vec, Mesh1d>;
+
+    auto op_L = [scheme](const Vec &var, Mesh1d &ex, double t) {
+        return scheme.op_L(var, ex, t);
+    };
+    auto get_dt = [scheme](const Vec &var, Mesh1d &ex, double t) {
+        return scheme.get_dt(var, ex, t);
+    };
+
+    auto solver = solver_stdfunc::Solver<Vec, Mesh1d>{};
+    if constexpr (Scheme::rk3) {
+        auto stage = [scheme](const Vec &var, Mesh1d &ex, double t) {
+            return stage_of(scheme, var, ex, t);
+        };
+        solver.set_update(Factory::get_rk3_updater(op_L, get_dt, {}, {}, stage));
+    }
+    else {
+        solver.set_update(Factory::get_euler_updater(op_L, get_dt, {}, {}));
+    }
+    return solver;
+}
+
+// template parameters
+
+template <typename Scheme>
+struct OpLOf {
+    Scheme scheme;
+
+    Vec operator()(const Vec &var, Mesh1d &ex, double t) const {
+        return scheme.op_L(var, ex, t);
+    }
+};
+
+template <typename Scheme>
+struct GetDtOf {
+    Scheme scheme;
+
+    double operator()(const Vec &var, Mesh1d &ex, double t) const {
+        return scheme.get_dt(var, ex, t);
+    }
+};
+
+template <typename Scheme>
+struct StageOf {
+    Scheme scheme;
+
+    Vec operator()(const Vec &var, Mesh1d &ex, double t) const {
+        return stage_of(scheme, var, ex, t);
+    }
+};
+
+template <typename Scheme>
+auto make_template_solver(const Scheme &scheme) {
+    using solver_template::EulerUpdater;
+    using solver_template::RK3Updater;
+    using solver_template::Solver;
+    using Null = solver_template::OpNull<Vec, Mesh1d>;
+
+    if constexpr (Scheme::rk3) {
+        using Updater = RK3Updater<Vec, Mesh1d, OpLOf<Scheme>, GetDtOf<Scheme>,
+                                   Null, Null, StageOf<Scheme>>;
+        return Solver<Vec, Mesh1d, Updater>{
+            Updater{{scheme}, {scheme}, {}, {}, {scheme}}};
+    }
+    else {
+        using Updater =
+            EulerUpdater<Vec, Mesh1d, OpLOf<Scheme>, GetDtOf<Scheme>, Null, Null>;
+        return Solver<Vec, Mesh1d, Updater>{
+            Updater{{scheme}, {scheme}, {}, {}}};
+    }
+}
+
+// counts time steps through get_dt, used once per case (untimed)
+template <typename Scheme>
+struct StepCounter : Scheme {
+    std::size_t *steps;
+
+    double get_dt(const Vec &var, Mesh1d &ex, double t) const {
+        ++(*steps);
+        return Scheme::get_dt(var, ex, t);
+    }
+};
+
+// benchmark driver
+
+struct Options {
+    std::vector<std::size_t> sizes;
+    std::size_t steps;
+    std::size_t reps;
+    std::size_t warmup;
+};
+
+struct Row {
+    std::string problem;
+    std::string framework;
+    std::size_t n;
+    std::size_t steps;
+    std::size_t reps;
+    bench::Stats ns;  // ns per cell-update
+};
+
+template <typename SolverType>
+void bench_framework(const std::string &problem, const std::string &framework,
+                     const SolverType &solver, const Vec &u0, double dx,
+                     double tend, std::size_t n, std::size_t steps,
+                     const Options &opt, std::vector<Row> &rows) {
+    auto samples = bench::measure(
+        [&]() {
+            auto ex = Mesh1d{dx};
+            auto result = solver.run(u0, ex, 0, tend);
+            bench::keep(result.value().data[0]);
+        },
+        opt.warmup, opt.reps);
+
+    auto cell_updates = static_cast<double>(n * steps);
+    for (auto &s : samples) s = s * 1e9 / cell_updates;
+
+    rows.push_back({problem, framework, n, steps, opt.reps,
+                    bench::summarize(samples)});
+
+    const auto &r = rows.back();
+    std::printf("%-12s %-9s %8zu %6zu %10.2f %8.2f %8.2f\n", problem.c_str(),
+                framework.c_str(), n, steps, r.ns.mean, r.ns.ci95, r.ns.min);
+}
+
+template <typename Scheme>
+void bench_problem(const std::string &problem, const Scheme &scheme,
+                   const std::vector<double> &u0_data, double dx,
+                   std::size_t n, const Options &opt, std::vector<Row> &rows) {
+    auto u0 = Vec{u0_data};
+
+    auto ex0 = Mesh1d{dx};
+    double tend = static_cast<double>(opt.steps) * scheme.get_dt(u0, ex0, 0);
+
+    std::size_t steps = 0;
+    {
+        auto counter = CrtpSolver<StepCounter<Scheme>>{{scheme, &steps}};
+        auto ex = Mesh1d{dx};
+        bench::keep(counter.run(u0, ex, 0, tend).value().data[0]);
+    }
+
+    bench_framework(problem, "virtual", VirtualSolver<Scheme>{scheme}, u0, dx,
+                    tend, n, steps, opt, rows);
+    bench_framework(problem, "stdfunc", make_stdfunc_solver(scheme), u0, dx,
+                    tend, n, steps, opt, rows);
+    bench_framework(problem, "crtp", CrtpSolver<Scheme>{scheme}, u0, dx, tend,
+                    n, steps, opt, rows);
+#ifdef HAS_DEDUCING_THIS
+    bench_framework(problem, "deducing", DeducingSolver<Scheme>{scheme}, u0,
+                    dx, tend, n, steps, opt, rows);
+#endif
+    bench_framework(problem, "template", make_template_solver(scheme), u0, dx,
+                    tend, n, steps, opt, rows);
+}
+
+void write_csv(const std::string &file_name, const std::vector<Row> &rows) {
+    std::fstream f(file_name, std::ios::out);
+    if (f.fail()) {
+        std::cerr << "bench_solver_frameworks: fail to open file " << file_name
+                  << std::endl;
+        exit(1);
+    }
+
+    f << "problem,framework,n,steps,reps,mean_ns,stddev_ns,ci95_ns,median_ns,"
+         "min_ns\n";
+    for (const auto &r : rows) {
+        f << r.problem << ',' << r.framework << ',' << r.n << ',' << r.steps
+          << ',' << r.reps << ',' << r.ns.mean << ',' << r.ns.stddev << ','
+          << r.ns.ci95 << ',' << r.ns.median << ',' << r.ns.min << '\n';
+    }
+    std::cout << "export to file " << file_name << '\n';
+}
+
+int main(int argc, char **argv) {
+    auto args = bench::Args(argc, argv);
+    auto opt = Options{
+        .sizes = args.get("--sizes", std::vector<std::size_t>{256, 4096, 65536}),
+        .steps = args.get("--steps", std::size_t{10}),
+        .reps = args.get("--reps", std::size_t{7}),
+        .warmup = args.get("--warmup", std::size_t{2}),
+    };
+    auto out = args.get("--out", std::string{OUTPUT_DIR "/bench_solver_frameworks.csv"});
+
+    const auto u0 = BurgersExact(0.5, 1.0, 1.0, 0, 1e-10);
+    const std::size_t DG_k = 2;
+    const std::size_t gauss_k = 7;
+
+    std::printf("%-12s %-9s %8s %6s %10s %8s %8s\n", "problem", "framework",
+                "n", "steps", "ns/cell", "+-ci95", "min");
+
+    std::vector<Row> rows;
+    for (auto n : opt.sizes) {
+        double dx = 0;
+        auto x = linespace_mid(-constant::pi, constant::pi, n, dx);
+
+        auto u_fv = std::vector<double>(n);
+        for (std::size_t j = 0; j < n; j++) u_fv[j] = u0.init_value(x[j]);
+
+        bench_problem("fv_godunov", schemes::FVGodunov{}, u_fv, dx, n, opt, rows);
+        bench_problem("fv_weno5", schemes::FVWENO5{}, u_fv, dx, n, opt, rows);
+        auto init = [&](double s) { return u0.init_value(s); };
+        bench_problem("dg_k2", schemes::DG{DG_k, gauss_k},
+                      modal_projection(init, x, dx, DG_k, gauss_k), dx, n,
+                      opt, rows);
+    }
+
+    write_csv(out, rows);
+    return 0;
+}
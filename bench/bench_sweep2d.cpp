@@ -0,0 +1,115 @@
+// Cost of the 2d dimension-by-dimension sweeps of FV2dWENO5.
+//
+// For each n * n mesh the report gives ns per cell for the x-sweep, the tiled
+// y-sweep at several strip widths, and a naive y-sweep that walks down each
+// column (stride nx) and recomputes the periodic neighbours per cell.
+//
+// usage: bench_sweep2d [--sizes 256,1024,4096] [--tiles 8,32,64,256]
+//                      [--reps 5] [--out file.csv]
+
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench_utils.hpp"
+
+#include "numerical_flux.hpp"
+#include "period_index.hpp"
+#include "schemes/sweep2d.hpp"
+#include "weno5.hpp"
+
+using namespace flux;  // NOLINT
+
+void naive_sweep_y(const std::vector<double> &u, std::vector<double> &L,
+                   const Mesh2d &ex) {
+    const std::size_t nx = ex.nx;
+    const std::size_t ny = ex.ny;
+    for (std::size_t i = 0; i < nx; i++) {
+        for (std::size_t j = 0; j < ny; j++) {
+            auto idx = PeriodIndex(ny, j);
+            auto at = [&](std::size_t jj) { return u[jj * nx + i]; };
+
+            double ul_c = 0;
+            double ur_c = 0;
+            double ul_r = 0;
+            double ur_r = 0;
+            double ul_l = 0;
+            double ur_l = 0;
+            weno5_point(at(idx.l(3)), at(idx.l(2)), at(idx.l()), at(idx.c()),
+                        at(idx.r()), ul_l, ur_l);
+            weno5_point(at(idx.l(2)), at(idx.l()), at(idx.c()), at(idx.r()),
+                        at(idx.r(2)), ul_c, ur_c);
+            weno5_point(at(idx.l()), at(idx.c()), at(idx.r()), at(idx.r(2)),
+                        at(idx.r(3)), ul_r, ur_r);
+
+            double fhat_l = fhat_LF(ur_l, ul_c);
+            double fhat_r = fhat_LF(ur_c, ul_r);
+            L[j * nx + i] += (fhat_l - fhat_r) / ex.dy;
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    auto args = bench::Args(argc, argv);
+    auto sizes = args.get("--sizes", std::vector<std::size_t>{256, 1024, 4096});
+    auto tiles = args.get("--tiles", std::vector<std::size_t>{8, 32, 64, 256});
+    auto reps = args.get("--reps", std::size_t{5});
+    auto out = args.get("--out", std::string{OUTPUT_DIR "/bench_sweep2d.csv"});
+
+    std::fstream f(out, std::ios::out);
+    if (f.fail()) {
+        std::cerr << "bench_sweep2d: fail to open file " << out << std::endl;
+        exit(1);
+    }
+    f << "sweep,n,tile,ns_per_cell,ci95\n";
+
+    auto rec = [](const std::array<const double *, 5> &s, std::size_t c,
+                  double &ul, double &ur) {
+        weno5_point(s[0][c], s[1][c], s[2][c], s[3][c], s[4][c], ul, ur);
+    };
+    auto fhat = [](double ul, double ur) { return fhat_LF(ul, ur); };
+
+    std::printf("%-8s %6s %6s %12s %10s\n", "sweep", "n", "tile", "ns/cell",
+                "ci95");
+
+    for (auto n : sizes) {
+        auto ex = Mesh2d{1.0 / static_cast<double>(n),
+                         1.0 / static_cast<double>(n), n, n};
+        auto u = std::vector<double>(n * n);
+        for (std::size_t k = 0; k < u.size(); k++) {
+            u[k] = 0.5 + std::sin(0.37 * static_cast<double>(k));
+        }
+        auto L = std::vector<double>(n * n);
+        auto cells = static_cast<double>(n * n);
+
+        auto report = [&](const char *name, std::size_t tile, auto &&func) {
+            auto s = bench::summarize(bench::measure(func, 1, reps));
+            double ns = s.median / cells * 1e9;
+            double ci = s.ci95 / cells * 1e9;
+            std::printf("%-8s %6zu %6zu %12.3f %10.3f\n", name, n, tile, ns,
+                        ci);
+            f << name << ',' << n << ',' << tile << ',' << ns << ',' << ci
+              << '\n';
+            bench::keep(L[n / 2]);
+        };
+
+        report("x", 0, [&]() {
+            schemes::sweep_x<2>(u.data(), L.data(), n, n, ex.dx, rec, fhat);
+        });
+        for (auto tile : tiles) {
+            report("y_tiled", tile, [&]() {
+                schemes::sweep_y<2>(schemes::periodic_rows(u, ex), L.data(), n,
+                                    0, n, ex.dy, tile, rec, fhat);
+            });
+        }
+        report("y_naive", 0, [&]() { naive_sweep_y(u, L, ex); });
+        std::printf("\n");
+    }
+
+    std::cout << "export to file " << out << '\n';
+    return 0;
+}
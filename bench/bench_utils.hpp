@@ -0,0 +1,114 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace flux::bench {
+
+struct Stats {
+    double mean;
+    double stddev;
+    double ci95;  // half width of the 95% confidence interval of the mean
+    double min;
+    double median;
+};
+
+// two-sided 95% quantile of Student's t distribution
+inline double t_quantile_95(std::size_t dof) {
+    constexpr double table[] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447,
+                                2.365,  2.306, 2.262, 2.228, 2.201, 2.179,
+                                2.160,  2.145, 2.131, 2.120, 2.110, 2.101,
+                                2.093,  2.086, 2.080, 2.074, 2.069, 2.064,
+                                2.060,  2.056, 2.052, 2.048, 2.045, 2.042};
+    if (dof == 0) return 0;
+    if (dof <= std::size(table)) return table[dof - 1];
+    return 1.960;
+}
+
+inline Stats summarize(std::vector<double> samples) {
+    Stats s{0, 0, 0, 0, 0};
+    auto n = samples.size();
+    if (n == 0) return s;
+
+    std::sort(samples.begin(), samples.end());
+    s.min = samples.front();
+    s.median = (n % 2 == 1) ? samples[n / 2]
+                            : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+
+    for (auto v : samples) s.mean += v;
+    s.mean /= static_cast<double>(n);
+
+    if (n > 1) {
+        double var = 0;
+        for (auto v : samples) var += (v - s.mean) * (v - s.mean);
+        s.stddev = std::sqrt(var / static_cast<double>(n - 1));
+        s.ci95 = t_quantile_95(n - 1) * s.stddev
+                 / std::sqrt(static_cast<double>(n));
+    }
+    return s;
+}
+
+// run func `warmup` times untimed, then `reps` times, return seconds per rep
+template <typename Func>
+std::vector<double> measure(Func &&func, std::size_t warmup,
+                            std::size_t reps) {
+    for (std::size_t i = 0; i < warmup; ++i) func();
+
+    std::vector<double> samples(reps);
+    for (std::size_t i = 0; i < reps; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        auto stop = std::chrono::steady_clock::now();
+        samples[i] = std::chrono::duration<double>(stop - start).count();
+    }
+    return samples;
+}
+
+inline volatile double sink = 0;
+
+// keep a value alive so the computation producing it is not optimized out
+inline void keep(double value) { sink = value; }
+
+// minimal "--key value" command line parsing
+class Args {
+public:
+    Args(int argc, char **argv) : m_args(argv + 1, argv + argc) {}
+
+    std::string get(const std::string &key, const std::string &fallback) const {
+        for (std::size_t i = 0; i + 1 < m_args.size(); ++i) {
+            if (m_args[i] == key) return m_args[i + 1];
+        }
+        return fallback;
+    }
+
+    std::size_t get(const std::string &key, std::size_t fallback) const {
+        auto s = get(key, std::string{});
+        return s.empty() ? fallback : std::stoul(s);
+    }
+
+    std::vector<std::size_t> get(const std::string &key,
+                                 const std::vector<std::size_t> &fallback) const {
+        auto s = get(key, std::string{});
+        if (s.empty()) return fallback;
+
+        std::vector<std::size_t> result;
+        std::size_t pos = 0;
+        while (pos < s.size()) {
+            auto next = s.find(',', pos);
+            if (next == std::string::npos) next = s.size();
+            result.push_back(std::stoul(s.substr(pos, next - pos)));
+            pos = next + 1;
+        }
+        return result;
+    }
+
+private:
+    std::vector<std::string> m_args;
+};
+
+}  // namespace flux::bench
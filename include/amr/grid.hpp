@@ -0,0 +1,322 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace flux::amr {
+
+// when and where Grid::adapt refines and coarsens
+struct RegridConfig {
+    size_t interval = 4;  // regrid every `interval` time steps, 0: never
+
+    // jump sensor of a block: max |u_{i+1} - u_i| over its cells and faces,
+    // a gradient criterion in smooth regions (O(dx)) that stays O(1) at shocks
+    double refine_tol = 0.05;
+    double coarsen_tol = 0.01;
+};
+
+// blocks of `block` cells, all at the same refinement level
+struct Block {
+    size_t level;
+    size_t index;           // position among the blocks of its level
+    std::vector<double> u;  // cell averages padded with halo ghost cells
+};
+
+// Block-structured AMR of a periodic 1d grid. Every block of `root_blocks`
+// coarse blocks is the root of a binary tree, a refined block is replaced
+// by two children with half the cell width. The leaves are stored from left
+// to right, neighbouring leaves differ by at most one level (2:1 balance).
+//
+// Prolongation is piecewise linear with minmod limited slopes, restriction
+// averages the two children; both conserve the integral of u.
+class Grid {
+public:
+    Grid(double xl, double xr, size_t root_blocks, size_t block, size_t halo,
+         size_t max_level)
+        : m_xl(xl), m_root_blocks(root_blocks), m_block(block), m_halo(halo),
+          m_max_level(max_level) {
+        if (root_blocks == 0 || block % 2 != 0 || block < 2 * halo) {
+            std::cerr << "amr::Grid: need root_blocks > 0 and an even block "
+                         "of at least 2 * halo cells"
+                      << std::endl;
+            exit(1);
+        }
+        m_dx0 = (xr - xl) / static_cast<double>(root_blocks * block);
+
+        for (size_t k = 0; k < root_blocks; k++) {
+            m_blocks.push_back(
+                Block{0, k, std::vector<double>(block + 2 * halo)});
+        }
+    }
+
+    size_t block() const { return m_block; }
+
+    size_t halo() const { return m_halo; }
+
+    size_t max_level() const { return m_max_level; }
+
+    std::vector<Block> &blocks() { return m_blocks; }
+
+    const std::vector<Block> &blocks() const { return m_blocks; }
+
+    size_t cells() const { return m_blocks.size() * m_block; }
+
+    double dx(size_t level) const {
+        return std::ldexp(m_dx0, -static_cast<int>(level));
+    }
+
+    size_t finest_level() const {
+        size_t level = 0;
+        for (const auto &b : m_blocks) level = std::max(level, b.level);
+        return level;
+    }
+
+    // left edge of cell i of block b
+    double x(const Block &b, size_t i) const {
+        return m_xl + static_cast<double>(b.index * m_block + i) * dx(b.level);
+    }
+
+    // set the cells to avg(a, b), the average over [a, b]
+    template <typename Func>
+    void project(const Func &avg) {
+        for (auto &b : m_blocks) {
+            for (size_t i = 0; i < m_block; i++) {
+                b.u[m_halo + i] = avg(x(b, i), x(b, i + 1));
+            }
+        }
+    }
+
+    // cell centres, widths and values of all leaf cells, from left to right
+    std::vector<double> centers() const {
+        return collect([&](const Block &b, size_t i) {
+            return x(b, i) + dx(b.level) / 2;
+        });
+    }
+
+    std::vector<double> widths() const {
+        return collect([&](const Block &b, size_t i) { return dx(b.level); });
+    }
+
+    std::vector<double> values() const {
+        return collect(
+            [&](const Block &b, size_t i) { return b.u[m_halo + i]; });
+    }
+
+    std::vector<double> levels() const {
+        return collect([&](const Block &b, size_t i) {
+            return static_cast<double>(b.level);
+        });
+    }
+
+    // ghost cells of every block at its own level, copied from neighbours at
+    // the same level, prolonged from coarser or restricted from finer ones
+    void fill_ghosts() {
+        for (size_t k = 0; k < m_blocks.size(); k++) fill_ghosts_of(k);
+    }
+
+    // the same for the blocks of one level only
+    void fill_ghosts(size_t level) {
+        for (size_t k = 0; k < m_blocks.size(); k++) {
+            if (m_blocks[k].level == level) fill_ghosts_of(k);
+        }
+    }
+
+    // one regrid pass: refine the blocks whose jump sensor exceeds
+    // refine_tol by one level, coarsen sibling pairs below coarsen_tol
+    void adapt(const RegridConfig &cfg) {
+        fill_ghosts();
+
+        const size_t nb = m_blocks.size();
+        auto target = std::vector<size_t>(nb);
+        for (size_t k = 0; k < nb; k++) {
+            const auto &b = m_blocks[k];
+            double eta = 0;
+            for (size_t i = m_halo; i <= m_halo + m_block; i++) {
+                eta = std::max(eta, std::abs(b.u[i] - b.u[i - 1]));
+            }
+
+            target[k] = b.level;
+            if (eta > cfg.refine_tol && b.level < m_max_level) target[k]++;
+            if (eta < cfg.coarsen_tol && b.level > 0) target[k]--;
+        }
+        balance(target);
+
+        auto blocks = std::vector<Block>{};
+        blocks.reserve(2 * nb);
+        for (size_t k = 0; k < nb; k++) {
+            auto &b = m_blocks[k];
+            if (target[k] > b.level) {
+                refine(b, blocks);
+            }
+            else if (target[k] < b.level) {
+                coarsen(b, m_blocks[k + 1], blocks);
+                k++;  // the right sibling
+            }
+            else {
+                blocks.push_back(std::move(b));
+            }
+        }
+        m_blocks = std::move(blocks);
+    }
+
+private:
+    static std::ptrdiff_t offset(size_t i) {
+        return static_cast<std::ptrdiff_t>(i);
+    }
+
+    static double minmod(double a, double b) {
+        if (a * b <= 0) return 0.0;
+        return (a > 0) ? std::min(a, b) : std::max(a, b);
+    }
+
+    void fill_ghosts_of(size_t k) {
+        const size_t nb = m_blocks.size();
+        auto &b = m_blocks[k];
+        const auto &left = m_blocks[(k + nb - 1) % nb];
+        const auto &right = m_blocks[(k + 1) % nb];
+
+        if (left.level == b.level) {
+            std::copy_n(left.u.begin() + offset(m_block), m_halo, b.u.begin());
+        }
+        else {
+            for (size_t g = 0; g < m_halo; g++) {
+                b.u[g] = sample(b.level, global(b, 0) - offset(m_halo - g));
+            }
+        }
+
+        if (right.level == b.level) {
+            std::copy_n(right.u.begin() + offset(m_halo), m_halo,
+                        b.u.begin() + offset(m_halo + m_block));
+        }
+        else {
+            for (size_t g = 0; g < m_halo; g++) {
+                b.u[m_halo + m_block + g] =
+                    sample(b.level, global(b, m_block) + offset(g));
+            }
+        }
+    }
+
+    template <typename Func>
+    std::vector<double> collect(const Func &func) const {
+        auto result = std::vector<double>{};
+        result.reserve(cells());
+        for (const auto &b : m_blocks) {
+            for (size_t i = 0; i < m_block; i++) result.push_back(func(b, i));
+        }
+        return result;
+    }
+
+    // index of cell i of block b among the cells of its level
+    std::ptrdiff_t global(const Block &b, size_t i) const {
+        return offset(b.index * m_block + i);
+    }
+
+    // leaf containing the cell p of the finest possible level
+    const Block &find(size_t p) const {
+        auto it = std::upper_bound(
+            m_blocks.begin(), m_blocks.end(), p,
+            [&](size_t q, const Block &b) { return q < start(b); });
+        return *(it - 1);
+    }
+
+    size_t start(const Block &b) const {
+        return (b.index * m_block) << (m_max_level - b.level);
+    }
+
+    // average of u over the cell p at `level` (periodic)
+    double sample(size_t level, std::ptrdiff_t p) const {
+        const auto n = offset((m_root_blocks * m_block) << level);
+        const auto q = static_cast<size_t>((p % n + n) % n);
+
+        const auto &b = find(q << (m_max_level - level));
+        if (b.level == level) return b.u[m_halo + q - b.index * m_block];
+        if (b.level > level) {
+            return 0.5
+                   * (sample(level + 1, offset(2 * q))
+                      + sample(level + 1, offset(2 * q + 1)));
+        }
+
+        const auto parent = offset(q / 2);
+        double c = sample(level - 1, parent);
+        double s = minmod(sample(level - 1, parent + 1) - c,
+                          c - sample(level - 1, parent - 1));
+        return (q % 2 == 0) ? c - s / 4 : c + s / 4;
+    }
+
+    // raise the target levels until sibling pairs coarsen together and
+    // neighbouring leaves differ by at most one level
+    void balance(std::vector<size_t> &target) const {
+        const size_t nb = m_blocks.size();
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (size_t k = 0; k < nb; k++) {
+                const auto &b = m_blocks[k];
+                if (target[k] >= b.level) continue;
+
+                size_t s = (b.index % 2 == 0) ? k + 1 : k - 1;
+                bool sibling = s < nb && m_blocks[s].level == b.level
+                               && m_blocks[s].index == (b.index ^ 1U)
+                               && target[s] < b.level;
+                if (!sibling) {
+                    target[k] = b.level;
+                    changed = true;
+                }
+            }
+
+            for (size_t k = 0; k < nb; k++) {
+                size_t r = (k + 1) % nb;
+                if (target[k] > target[r] + 1) {
+                    target[r] = target[k] - 1;
+                    changed = true;
+                }
+                if (target[r] > target[k] + 1) {
+                    target[k] = target[r] - 1;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    // two children of b, b must have its ghost cells filled
+    void refine(const Block &b, std::vector<Block> &out) const {
+        for (size_t half = 0; half < 2; half++) {
+            auto child = Block{b.level + 1, 2 * b.index + half,
+                               std::vector<double>(m_block + 2 * m_halo)};
+            for (size_t i = 0; i < m_block / 2; i++) {
+                size_t c = m_halo + half * m_block / 2 + i;
+                double s = minmod(b.u[c + 1] - b.u[c], b.u[c] - b.u[c - 1]);
+                child.u[m_halo + 2 * i] = b.u[c] - s / 4;
+                child.u[m_halo + 2 * i + 1] = b.u[c] + s / 4;
+            }
+            out.push_back(std::move(child));
+        }
+    }
+
+    // parent of the siblings l and r
+    void coarsen(const Block &l, const Block &r,
+                 std::vector<Block> &out) const {
+        auto parent = Block{l.level - 1, l.index / 2,
+                            std::vector<double>(m_block + 2 * m_halo)};
+        for (size_t i = 0; i < m_block; i++) {
+            const auto &child = (i < m_block / 2) ? l : r;
+            size_t c = m_halo + 2 * (i % (m_block / 2));
+            parent.u[m_halo + i] = 0.5 * (child.u[c] + child.u[c + 1]);
+        }
+        out.push_back(std::move(parent));
+    }
+
+    double m_xl;
+    double m_dx0{0};
+    size_t m_root_blocks;
+    size_t m_block;
+    size_t m_halo;
+    size_t m_max_level;
+    std::vector<Block> m_blocks;
+};
+
+}  // namespace flux::amr
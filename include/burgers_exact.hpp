@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cmath>
+#include <concepts>
 #include <iostream>
 #include <string>
 
@@ -9,52 +10,54 @@ namespace flux {
 // burgers equation
 // u0(x) = a + b sin(w x + phi) in [xl,xr]
 // periodic boundary condition
-class BurgersExact {
+// evaluated in the scalar type T, BurgersExact is the double instance
+template <std::floating_point T>
+class BasicBurgersExact {
 public:
-    BurgersExact(double a, double b, double w, double phi, double ep)
+    BasicBurgersExact(T a, T b, T w, T phi, T ep)
         : m_a(a), m_b(b), m_w(w), m_phi(phi), m_ep(ep) {}
 
-    double init_value(double x) const {
-        return m_a + m_b * sin(m_w * x + m_phi);
+    T init_value(T x) const {
+        return m_a + m_b * std::sin(m_w * x + m_phi);
     }
 
-    double eval(double x, double t) const {
-        double x2 = m_w * x + m_phi - m_a * m_w * t;
-        double t2 = m_b * m_w * t;
+    T eval(T x, T t) const {
+        T x2 = m_w * x + m_phi - m_a * m_w * t;
+        T t2 = m_b * m_w * t;
         return m_a + m_b * eval_kernel(x2, t2, m_ep);
     }
 
-    double eval_with_check(double x, double t) const {
+    T eval_with_check(T x, T t) const {
         if (t >= get_tb())
             raise_error(x, t, "t >= tb: " + std::to_string(get_tb()));
 
         return eval(x, t);
     }
 
-    double get_tb() const { return std::abs(1.0 / (m_b * m_w)); }
+    T get_tb() const { return std::abs(1 / (m_b * m_w)); }
 
 private:
     // u0(x) = sin(x)
-    static double eval_kernel(double x, double t, double ep) {
+    static T eval_kernel(T x, T t, T ep) {
         // check input
         if (t < 0) { raise_error(x, t, "t < 0: " + std::to_string(t)); }
-        if (ep <= 0) { ep = 1e-6; }
+        if (ep <= 0) { ep = static_cast<T>(1e-6); }
 
         // keep x in [-pi,pi]
         while (x < -pi) { x += 2 * pi; }
         while (x >= pi) { x -= 2 * pi; }
 
         // initial value
-        double k = 1.0 / (pi / 2 + t);
-        double u = k * x;
+        T k = 1 / (pi / 2 + t);
+        T u = k * x;
 
         // Newton iteration
         // G(u) = u - sin(x - u * t) = 0
         const std::size_t iter_max = 1000000;
         std::size_t iter = 0;
         while (iter < iter_max) {
-            double tmp = 1 + cos(x - u * t) * t;
-            double du = (u - sin(x - u * t)) / tmp;
+            T tmp = 1 + std::cos(x - u * t) * t;
+            T du = (u - std::sin(x - u * t)) / tmp;
             u = u - du;
 
             iter++;
@@ -72,12 +75,14 @@ private:
         exit(1);
     }
 
-    inline static constexpr double pi = 3.14159265358979323846;
+    inline static constexpr T pi = static_cast<T>(3.14159265358979323846);
 
-    const double m_a;
-    const double m_b;
-    const double m_w;
-    const double m_phi;
-    const double m_ep;
+    const T m_a;
+    const T m_b;
+    const T m_w;
+    const T m_phi;
+    const T m_ep;
 };
+
+using BurgersExact = BasicBurgersExact<double>;
 }  // namespace flux
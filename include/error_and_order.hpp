@@ -1,11 +1,15 @@
 #pragma once
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <fstream>
 #include <iostream>
+#include <thread>
 #include <vector>
 
+#include "parallel/thread_team.hpp"
+
 #if __has_include(<format>)
 #include <format>
 #define USE_FORMAT
@@ -44,6 +48,112 @@ inline double error(const std::vector<double> &u1,
     return result;
 }
 
+struct ErrorNorms {
+    double l1;
+    double l2;
+    double linf;
+};
+
+namespace detail {
+
+inline constexpr size_t norm_block = 256;
+
+// no thread for fewer cells
+inline constexpr size_t norm_cells_per_thread = 1 << 16;
+
+// sums of |e| and e^2 (weighted), max of |e|
+struct NormSums {
+    double l1 = 0;
+    double l2 = 0;
+    double linf = 0;
+};
+
+inline NormSums combine(const NormSums &a, const NormSums &b) {
+    return {a.l1 + b.l1, a.l2 + b.l2, std::max(a.linf, b.linf)};
+}
+
+// Pairwise sum of block_sums(b) over the blocks [first, last), so the rounding
+// error grows with log(blocks) instead of the number of cells. The two halves
+// of the top levels run on up to `threads` threads; the tree does not depend
+// on it, neither does the result.
+template <typename BlockSums>
+NormSums pairwise_sums(const BlockSums &block_sums, size_t first, size_t last,
+                       size_t threads) {
+    if (last - first == 1) return block_sums(first);
+    size_t mid = first + (last - first) / 2;
+    NormSums right;
+    if (threads > 1) {
+        std::jthread worker([&]() {
+            right = pairwise_sums(block_sums, mid, last, threads - threads / 2);
+        });
+        auto left = pairwise_sums(block_sums, first, mid, threads / 2);
+        worker.join();
+        return combine(left, right);
+    }
+    auto left = pairwise_sums(block_sums, first, mid, 1);
+    right = pairwise_sums(block_sums, mid, last, 1);
+    return combine(left, right);
+}
+
+// pairwise_sums over the blocks of norm_block cells of n cells, threads = 0
+// for FLUX_NUM_THREADS or the hardware threads
+template <typename BlockSums>
+NormSums block_norm_sums(const BlockSums &block_sums, size_t n,
+                         size_t threads) {
+    if (n == 0) return {};
+    if (threads == 0) threads = parallel::default_thread_count();
+    threads = std::clamp<size_t>(
+        threads, 1, std::max<size_t>(n / norm_cells_per_thread, 1));
+    return pairwise_sums(block_sums, 0, (n + norm_block - 1) / norm_block,
+                         threads);
+}
+
+}  // namespace detail
+
+// L1, L2 and Linf norms of u1 - u2 in one pass, the same as error() with the
+// three ErrorTypes but with pairwise sums
+inline ErrorNorms error_norms(const std::vector<double> &u1,
+                              const std::vector<double> &u2, double dx,
+                              size_t threads = 0) {
+    size_t len = u1.size();
+    if (u2.size() != len) {
+        std::cerr << "error_norms: u1 and u2 have different length"
+                  << std::endl;
+        exit(1);
+    }
+
+    // four independent accumulators per block, so the loop vectorizes
+    auto block_sums = [&](size_t b) {
+        const size_t first = b * detail::norm_block;
+        const size_t last = std::min(first + detail::norm_block, len);
+        double l1[4] = {0, 0, 0, 0};
+        double l2[4] = {0, 0, 0, 0};
+        double linf[4] = {0, 0, 0, 0};
+        size_t i = first;
+        for (; i + 4 <= last; i += 4) {
+            for (size_t k = 0; k < 4; k++) {
+                double e = std::abs(u1[i + k] - u2[i + k]);
+                l1[k] += e;
+                l2[k] += e * e;
+                linf[k] = std::max(linf[k], e);
+            }
+        }
+        for (size_t k = 0; i < last; i++, k++) {
+            double e = std::abs(u1[i] - u2[i]);
+            l1[k] += e;
+            l2[k] += e * e;
+            linf[k] = std::max(linf[k], e);
+        }
+        return detail::NormSums{
+            (l1[0] + l1[1]) + (l1[2] + l1[3]),
+            (l2[0] + l2[1]) + (l2[2] + l2[3]),
+            std::max(std::max(linf[0], linf[1]), std::max(linf[2], linf[3]))};
+    };
+
+    auto sums = detail::block_norm_sums(block_sums, len, threads);
+    return {sums.l1 * dx, std::sqrt(sums.l2 * dx), sums.linf};
+}
+
 inline std::vector<double> order(const std::vector<double> &error,
                                  const std::vector<size_t> &nlist) {
     auto len = error.size();
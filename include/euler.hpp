@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+
+namespace flux::euler {
+
+// 1d Euler equations of an ideal gas, U = (rho, rho u, E),
+// E = p / (gas_gamma - 1) + rho u^2 / 2
+constexpr double gas_gamma = 1.4;
+
+using State = std::array<double, 3>;
+
+struct Primitive {
+    double rho;
+    double u;
+    double p;
+};
+
+inline State conserved(const Primitive &w) {
+    return {w.rho, w.rho * w.u,
+            w.p / (gas_gamma - 1) + w.rho * w.u * w.u / 2};
+}
+
+inline Primitive primitive(const State &U) {
+    double u = U[1] / U[0];
+    return {U[0], u, (gas_gamma - 1) * (U[2] - U[1] * u / 2)};
+}
+
+inline double sound_speed(const Primitive &w) {
+    return std::sqrt(gas_gamma * w.p / w.rho);
+}
+
+inline State physical_flux(const State &U, const Primitive &w) {
+    return {U[1], U[1] * w.u + w.p, (U[2] + w.p) * w.u};
+}
+
+// max |u| + c
+inline double max_speed(const State &U) {
+    auto w = primitive(U);
+    return std::abs(w.u) + sound_speed(w);
+}
+
+// Eigenvectors of the flux Jacobian at the Roe average of UL and UR, for the
+// characteristic decomposition W = L U. R[k] is the right eigenvector of
+// u - c, u, u + c for k = 0, 1, 2, L[k] the matching left eigenvector.
+struct Eigensystem {
+    std::array<State, 3> L;
+    std::array<State, 3> R;
+
+    State to_characteristic(const State &U) const {
+        State W{};
+        for (size_t k = 0; k < 3; k++) {
+            W[k] = L[k][0] * U[0] + L[k][1] * U[1] + L[k][2] * U[2];
+        }
+        return W;
+    }
+
+    State from_characteristic(const State &W) const {
+        State U{};
+        for (size_t c = 0; c < 3; c++) {
+            U[c] = R[0][c] * W[0] + R[1][c] * W[1] + R[2][c] * W[2];
+        }
+        return U;
+    }
+};
+
+inline Eigensystem roe_eigensystem(const State &UL, const State &UR) {
+    auto wl = primitive(UL);
+    auto wr = primitive(UR);
+    double sl = std::sqrt(wl.rho);
+    double sr = std::sqrt(wr.rho);
+    double hl = (UL[2] + wl.p) / wl.rho;
+    double hr = (UR[2] + wr.p) / wr.rho;
+
+    double u = (sl * wl.u + sr * wr.u) / (sl + sr);
+    double h = (sl * hl + sr * hr) / (sl + sr);
+    double c = std::sqrt((gas_gamma - 1) * (h - u * u / 2));
+
+    double b1 = (gas_gamma - 1) / (c * c);
+    double b2 = b1 * u * u / 2;
+
+    Eigensystem e{};
+    e.R[0] = {1, u - c, h - u * c};
+    e.R[1] = {1, u, u * u / 2};
+    e.R[2] = {1, u + c, h + u * c};
+    e.L[0] = {(b2 + u / c) / 2, -(b1 * u + 1 / c) / 2, b1 / 2};
+    e.L[1] = {1 - b2, b1 * u, -b1};
+    e.L[2] = {(b2 - u / c) / 2, -(b1 * u - 1 / c) / 2, b1 / 2};
+    return e;
+}
+
+// numerical flux of the Euler equations as a compile-time policy of the
+// schemes, like FluxPolicy for the scalar laws
+template <typename R>
+concept RiemannSolver = requires(const State &U) {
+    { R::flux(U, U) } -> std::convertible_to<State>;
+};
+
+// local Lax-Friedrichs
+struct Rusanov {
+    static State flux(const State &UL, const State &UR) {
+        auto wl = primitive(UL);
+        auto wr = primitive(UR);
+        double s = std::max(std::abs(wl.u) + sound_speed(wl),
+                            std::abs(wr.u) + sound_speed(wr));
+
+        auto fl = physical_flux(UL, wl);
+        auto fr = physical_flux(UR, wr);
+        State F{};
+        for (size_t c = 0; c < 3; c++) {
+            F[c] = 0.5 * (fl[c] + fr[c]) - 0.5 * s * (UR[c] - UL[c]);
+        }
+        return F;
+    }
+};
+
+// HLLC (Toro), wave speed estimates of Davis
+struct HLLC {
+    static State flux(const State &UL, const State &UR) {
+        auto wl = primitive(UL);
+        auto wr = primitive(UR);
+        double cl = sound_speed(wl);
+        double cr = sound_speed(wr);
+        double sl = std::min(wl.u - cl, wr.u - cr);
+        double sr = std::max(wl.u + cl, wr.u + cr);
+
+        if (sl >= 0) return physical_flux(UL, wl);
+        if (sr <= 0) return physical_flux(UR, wr);
+
+        double ml = wl.rho * (sl - wl.u);
+        double mr = wr.rho * (sr - wr.u);
+        double s = (wr.p - wl.p + ml * wl.u - mr * wr.u) / (ml - mr);
+
+        // F_K + S_K (U*_K - U_K) on the side K of the contact
+        auto side = [s](const State &U, const Primitive &w, double sk,
+                        double mk) {
+            double q = mk / (sk - s);
+            State star = {q, q * s,
+                          q * (U[2] / w.rho + (s - w.u) * (s + w.p / mk))};
+            auto F = physical_flux(U, w);
+            for (size_t c = 0; c < 3; c++) F[c] += sk * (star[c] - U[c]);
+            return F;
+        };
+        return (s >= 0) ? side(UL, wl, sl, ml) : side(UR, wr, sr, mr);
+    }
+};
+
+}  // namespace flux::euler
@@ -59,4 +59,33 @@ inline void export_to_file(const std::string &file_name,
     std::cout << "export to file " << file_name << '\n';
     return;
 }
+
+inline void export_to_file(const std::string &file_name,
+                           const std::vector<double> &x,
+                           const std::vector<double> &y,
+                           const std::vector<double> &z,
+                           const std::vector<double> &w, char delimiter) {
+    if (file_name.empty()) return;
+
+    std::fstream f(file_name, std::ios::out);
+
+    if (f.fail()) {
+        std::cerr << "export_to_file: fail to open file " << file_name
+                  << std::endl;
+        exit(1);
+    }
+
+    size_t row = x.size();
+    for (size_t len : {y.size(), z.size(), w.size()}) {
+        row = (row < len) ? row : len;
+    }
+    for (std::size_t i = 0; i < row; i++) {
+        f << x[i] << delimiter << y[i] << delimiter << z[i] << delimiter
+          << w[i] << "\n";
+    }
+
+    f.close();
+    std::cout << "export to file " << file_name << '\n';
+    return;
+}
 }  // namespace flux
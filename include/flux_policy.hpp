@@ -0,0 +1,152 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+
+namespace flux {
+
+// Scalar conservation law u_t + f(u)_x = 0 as a compile-time policy of the
+// numerical fluxes and schemes:
+//
+//   f(u)               flux
+//   df(u)              f'(u)
+//   max_speed(ul, ur)  max |f'(u)| for u between ul and ur
+//   riemann(ul, ur)    exact Riemann (Godunov) flux at u(0, t)
+//
+// All members are static, so every call inlines into the scheme kernels.
+// They are templates on the floating point type T of u and compute in T.
+template <typename F>
+concept FluxPolicy = requires(double u) {
+    { F::f(u) } -> std::convertible_to<double>;
+    { F::df(u) } -> std::convertible_to<double>;
+    { F::max_speed(u, u) } -> std::convertible_to<double>;
+    { F::riemann(u, u) } -> std::convertible_to<double>;
+};
+
+// f(u) = u^2 / 2
+struct Burgers {
+    template <std::floating_point T>
+    static T f(T u) {
+        return u * u / 2;
+    }
+
+    template <std::floating_point T>
+    static T df(T u) {
+        return u;
+    }
+
+    template <std::floating_point T>
+    static T max_speed(T ul, T ur) {
+        return std::max(std::abs(ul), std::abs(ur));
+    }
+
+    template <std::floating_point T>
+    static T riemann(T ul, T ur) {
+        if (ul <= ur) {  // min
+            if (ul * ur > 0) { return std::min(ul * ul / 2, ur * ur / 2); }
+            return 0;
+        }
+        return std::max(ul * ul / 2, ur * ur / 2);  // max
+    }
+};
+
+// f(u) = a u
+template <double A = 1.0>
+struct LinearAdvection {
+    static constexpr double a = A;
+
+    template <std::floating_point T>
+    static T f(T u) {
+        return static_cast<T>(a) * u;
+    }
+
+    template <std::floating_point T>
+    static T df(T u) {
+        return static_cast<T>(a);
+    }
+
+    template <std::floating_point T>
+    static T max_speed(T ul, T ur) {
+        return static_cast<T>(std::abs(a));
+    }
+
+    template <std::floating_point T>
+    static T riemann(T ul, T ur) {
+        return (a >= 0) ? static_cast<T>(a) * ul : static_cast<T>(a) * ur;
+    }
+};
+
+namespace detail {
+// argmax of f' on [0, 1] for the Buckley-Leverett flux, by ternary search
+constexpr double buckley_leverett_argmax(double m) {
+    auto df = [m](double u) {
+        double d = u * u + m * (1 - u) * (1 - u);
+        return u * (1 - u) / (d * d);
+    };
+    double a = 0;
+    double b = 1;
+    for (int k = 0; k < 200; k++) {
+        double c = a + (b - a) / 3;
+        double d = b - (b - a) / 3;
+        if (df(c) < df(d)) {
+            a = c;
+        }
+        else {
+            b = d;
+        }
+    }
+    return (a + b) / 2;
+}
+}  // namespace detail
+
+// f(u) = u^2 / (u^2 + m (1 - u)^2), non-convex, increasing on [0, 1]
+template <double M = 0.5>
+struct BuckleyLeverett {
+    static constexpr double m = M;
+
+    template <std::floating_point T>
+    static constexpr T f(T u) {
+        const auto mt = static_cast<T>(m);
+        return u * u / (u * u + mt * (1 - u) * (1 - u));
+    }
+
+    template <std::floating_point T>
+    static constexpr T df(T u) {
+        const auto mt = static_cast<T>(m);
+        T d = u * u + mt * (1 - u) * (1 - u);
+        return 2 * mt * u * (1 - u) / (d * d);
+    }
+
+    template <std::floating_point T>
+    static T max_speed(T ul, T ur) {
+        const auto ui = static_cast<T>(u_inflection);
+        T lo = std::min(ul, ur);
+        T hi = std::max(ul, ur);
+        T s = std::max(std::abs(df(lo)), std::abs(df(hi)));
+        if (lo < ui && ui < hi) { s = std::max(s, df(ui)); }
+        return s;
+    }
+
+    // min of f over [ul, ur] or max over [ur, ul], the extrema of f are at
+    // the end points or at u = 0, 1
+    template <std::floating_point T>
+    static T riemann(T ul, T ur) {
+        T lo = std::min(ul, ur);
+        T hi = std::max(ul, ur);
+        T fmin = std::min(f(ul), f(ur));
+        T fmax = std::max(f(ul), f(ur));
+        for (T u : {T(0), T(1)}) {
+            if (lo < u && u < hi) {
+                fmin = std::min(fmin, f(u));
+                fmax = std::max(fmax, f(u));
+            }
+        }
+        return (ul <= ur) ? fmin : fmax;
+    }
+
+    // inflection point, where f' has its max on [0, 1]
+    static constexpr double u_inflection = detail::buckley_leverett_argmax(m);
+};
+
+}  // namespace flux
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <utility>
+
+#include "gaussquad/gaussquad.hpp"
+
+namespace flux {
+// the Gauss-Legendre rule of k points (points, weights), computed once per
+// thread, for the kernels that integrate every stage
+inline const auto &gauss_rule(std::size_t k) {
+    using Rule = decltype(gaussquad::gausslegendre(1));
+    thread_local auto rules = std::map<std::size_t, Rule>{};
+    auto it = rules.find(k);
+    if (it == rules.end()) {
+        auto rule = gaussquad::gausslegendre(static_cast<unsigned>(k));
+        it = rules.emplace(k, std::move(rule)).first;
+    }
+    return it->second;
+}
+}  // namespace flux
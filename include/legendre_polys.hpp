@@ -1,7 +1,9 @@
 #pragma once
 
+#include <concepts>
 #include <iostream>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 namespace flux {
@@ -12,44 +14,52 @@ class LegendrePolys {
     }
 
 public:
-    static double eval(std::size_t n, double x) {
+    template <std::floating_point T = double>
+    static T eval(std::size_t n, std::type_identity_t<T> x) {
         switch (n) {
-        case 0: return f0(x);
-        case 1: return f1(x);
-        case 2: return f2(x);
-        case 3: return f3(x);
-        case 4: return f4(x);
-        case 5: return f5(x);
-        case 6: return f6(x);
+        case 0: return f0<T>(x);
+        case 1: return f1<T>(x);
+        case 2: return f2<T>(x);
+        case 3: return f3<T>(x);
+        case 4: return f4<T>(x);
+        case 5: return f5<T>(x);
+        case 6: return f6<T>(x);
         default:
             raise_error("LegendrePolys: out of range " + std::to_string(n));
             return 0;
         }
     }
 
-    [[maybe_unused]] constexpr static double f0(double x) { return 1; };
+    template <std::floating_point T>
+    [[maybe_unused]] constexpr static T f0(T x) { return 1; }
 
-    [[maybe_unused]] constexpr static double f1(double x) { return x; };
+    template <std::floating_point T>
+    [[maybe_unused]] constexpr static T f1(T x) { return x; }
 
-    [[maybe_unused]] constexpr static double f2(double x) {
-        return (3 * x * x - 1) / 2.0;
-    };
+    template <std::floating_point T>
+    [[maybe_unused]] constexpr static T f2(T x) {
+        return (3 * x * x - 1) / T(2);
+    }
 
-    [[maybe_unused]] constexpr static double f3(double x) {
-        return (5 * x * x - 3) * x / 2.0;
-    };
+    template <std::floating_point T>
+    [[maybe_unused]] constexpr static T f3(T x) {
+        return (5 * x * x - 3) * x / T(2);
+    }
 
-    [[maybe_unused]] constexpr static double f4(double x) {
-        return ((35 * x * x - 30) * x * x + 3) / 8.0;
-    };
+    template <std::floating_point T>
+    [[maybe_unused]] constexpr static T f4(T x) {
+        return ((35 * x * x - 30) * x * x + 3) / T(8);
+    }
 
-    [[maybe_unused]] constexpr static double f5(double x) {
-        return ((63 * x * x - 70) * x * x + 15) * x / 8.0;
-    };
+    template <std::floating_point T>
+    [[maybe_unused]] constexpr static T f5(T x) {
+        return ((63 * x * x - 70) * x * x + 15) * x / T(8);
+    }
 
-    [[maybe_unused]] constexpr static double f6(double x) {
-        return (((231 * x * x - 315) * x * x + 105) * x * x - 5) / 16.0;
-    };
+    template <std::floating_point T>
+    [[maybe_unused]] constexpr static T f6(T x) {
+        return (((231 * x * x - 315) * x * x + 105) * x * x - 5) / T(16);
+    }
 };
 
 class LegendrePolysDx {
@@ -59,50 +69,58 @@ class LegendrePolysDx {
     }
 
 public:
-    static double eval(std::size_t n, double x) {
+    template <std::floating_point T = double>
+    static T eval(std::size_t n, std::type_identity_t<T> x) {
         switch (n) {
-        case 0: return f0(x);
-        case 1: return f1(x);
-        case 2: return f2(x);
-        case 3: return f3(x);
-        case 4: return f4(x);
-        case 5: return f5(x);
-        case 6: return f6(x);
+        case 0: return f0<T>(x);
+        case 1: return f1<T>(x);
+        case 2: return f2<T>(x);
+        case 3: return f3<T>(x);
+        case 4: return f4<T>(x);
+        case 5: return f5<T>(x);
+        case 6: return f6<T>(x);
         default:
             raise_error("LegendrePolysDx: out of range " + std::to_string(n));
             return 0;
         }
     }
 
-    [[maybe_unused]] constexpr static double f0(double x) { return 0; };
+    template <std::floating_point T>
+    [[maybe_unused]] constexpr static T f0(T x) { return 0; }
 
-    [[maybe_unused]] constexpr static double f1(double x) { return 1; };
+    template <std::floating_point T>
+    [[maybe_unused]] constexpr static T f1(T x) { return 1; }
 
-    [[maybe_unused]] constexpr static double f2(double x) { return 3 * x; };
+    template <std::floating_point T>
+    [[maybe_unused]] constexpr static T f2(T x) { return 3 * x; }
 
-    [[maybe_unused]] constexpr static double f3(double x) {
-        return (15 * x * x - 3) / 2.0;
-    };
+    template <std::floating_point T>
+    [[maybe_unused]] constexpr static T f3(T x) {
+        return (15 * x * x - 3) / T(2);
+    }
 
-    [[maybe_unused]] constexpr static double f4(double x) {
-        return (140 * x * x - 60) * x / 8.0;
-    };
+    template <std::floating_point T>
+    [[maybe_unused]] constexpr static T f4(T x) {
+        return (140 * x * x - 60) * x / T(8);
+    }
 
-    [[maybe_unused]] constexpr static double f5(double x) {
-        return ((315 * x * x - 210) * x * x + 15) / 8.0;
-    };
+    template <std::floating_point T>
+    [[maybe_unused]] constexpr static T f5(T x) {
+        return ((315 * x * x - 210) * x * x + 15) / T(8);
+    }
 
-    [[maybe_unused]] constexpr static double f6(double x) {
-        return ((1386 * x * x - 1260) * x * x + 210) * x / 16.0;
-    };
+    template <std::floating_point T>
+    [[maybe_unused]] constexpr static T f6(T x) {
+        return ((1386 * x * x - 1260) * x * x + 210) * x / T(16);
+    }
 };
 
-template <typename Poly>
-double evals(const std::vector<double> &vec, double x, size_t id_start,
-             size_t id_len) {
-    double result = 0;
+template <typename Poly, std::floating_point T>
+T evals(const std::vector<T> &vec, std::type_identity_t<T> x,
+        size_t id_start, size_t id_len) {
+    T result = 0;
     for (size_t i = 0; i < id_len; i++) {
-        result += (vec[id_start + i] * Poly::eval(i, x));
+        result += (vec[id_start + i] * Poly::template eval<T>(i, x));
     }
 
     return result;
@@ -1,15 +1,18 @@
 #pragma once
 
 #include <cmath>
+#include <concepts>
 #include <vector>
 
 namespace flux {
-class Limiter {
+// TVB limiter in the scalar type T, Limiter is the double instance
+template <std::floating_point T>
+class BasicLimiter {
 public:
-    explicit Limiter(double tvb_M) : m_tvb_M(tvb_M) {}
+    explicit BasicLimiter(T tvb_M) : m_tvb_M(tvb_M) {}
 
-    void minmod(double &ret_uleft_p, double &ret_uright_m, double uleft_mean,
-                double u_mean, double uright_mean) const {
+    void minmod(T &ret_uleft_p, T &ret_uright_m, T uleft_mean, T u_mean,
+                T uright_mean) const {
         bool flag{false};
 
         auto tmp1 = minmod_kernel(ret_uright_m - u_mean, uright_mean - u_mean,
@@ -21,14 +24,14 @@ public:
         ret_uleft_p = u_mean - tmp2;
     }
 
-    double minmod_kernel(double a1, double a2, double a3, bool &flag) const {
+    T minmod_kernel(T a1, T a2, T a3, bool &flag) const {
         if (std::fabs(a1) < m_tvb_M) return a1;
 
         if (a1 > 0 && a2 > 0 && a3 > 0) {  // all positive, return min
             if (a1 > a2 || a1 > a3) {
                 flag = true;  // changed if a1 is not min
             }
-            double tmp = (a1 < a2) ? a1 : a2;
+            T tmp = (a1 < a2) ? a1 : a2;
             return (tmp < a3) ? tmp : a3;
         }
 
@@ -36,7 +39,7 @@ public:
             if (a1 < a2 || a1 < a3) {
                 flag = true;  // changed if a1 is not max
             }
-            double tmp = (a1 > a2) ? a1 : a2;
+            T tmp = (a1 > a2) ? a1 : a2;
             return (tmp > a3) ? tmp : a3;
         }
 
@@ -45,9 +48,8 @@ public:
         return 0;
     }
 
-    static void DG_recover(std::vector<double> &ret_u, size_t id_start,
-                           size_t DG_k, double mean, double left,
-                           double right) {
+    static void DG_recover(std::vector<T> &ret_u, size_t id_start,
+                           size_t DG_k, T mean, T left, T right) {
         if (DG_k == 0) { ret_u[id_start] = mean; }
         else if (DG_k == 1) {
             ret_u[id_start] = mean;
@@ -55,8 +57,9 @@ public:
         }
         else if (DG_k >= 2) {
             ret_u[id_start] = mean;
-            ret_u[id_start + 1] = -0.5 * left + 0.5 * right;
-            ret_u[id_start + 2] = -mean + 0.5 * left + 0.5 * right;
+            constexpr T half = static_cast<T>(0.5);
+            ret_u[id_start + 1] = -half * left + half * right;
+            ret_u[id_start + 2] = -mean + half * left + half * right;
 
             for (size_t j = 3; j <= DG_k; j++) {
                 ret_u[id_start + j] = 0;  // ignore
@@ -67,6 +70,8 @@ public:
     }
 
 private:
-    double m_tvb_M{0};
+    T m_tvb_M{0};
 };
+
+using Limiter = BasicLimiter<double>;
 }  // namespace flux
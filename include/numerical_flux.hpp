@@ -0,0 +1,27 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+
+#include "flux_policy.hpp"
+
+namespace flux {
+// numerical fluxes of the scalar law F, burgers equation f(u) = u^2/2 by
+// default, computed in the floating point type T of the traces
+
+template <FluxPolicy F = Burgers, std::floating_point T>
+inline T fhat_godunov(T ul, T ur) {
+    return F::riemann(ul, ur);
+}
+
+template <FluxPolicy F = Burgers, std::floating_point T>
+inline T fhat_LF(T ul, T ur) {
+    constexpr T half = static_cast<T>(0.5);
+    T c = F::max_speed(ul, ur);
+
+    T tmp1 = half * (F::f(ul) + F::f(ur));
+    T tmp2 = half * c * (ur - ul);
+    return tmp1 - tmp2;
+}
+}  // namespace flux
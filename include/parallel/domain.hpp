@@ -0,0 +1,132 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "partition.hpp"
+#include "thread_team.hpp"
+
+namespace flux::parallel {
+
+// Slice [begin, end) of the cells of a periodic grid owned by one thread.
+// The state is stored with `halo` ghost cells on each side, every cell holds
+// `block` doubles. The boundary cells are published in the send buffers, from
+// which the neighbours fill their ghost cells.
+class Subdomain {
+public:
+    // allocate on the owning thread, so its pages are first touched there
+    void allocate(std::size_t begin, std::size_t end, std::size_t halo,
+                  std::size_t block) {
+        m_begin = begin;
+        m_end = end;
+        m_halo = halo;
+        m_block = block;
+        m_data = std::vector<double>((end - begin + 2 * halo) * block);
+        for (auto &buf : m_send_left) buf = std::vector<double>(halo * block);
+        for (auto &buf : m_send_right) buf = std::vector<double>(halo * block);
+    }
+
+    std::size_t begin() const { return m_begin; }
+
+    std::size_t end() const { return m_end; }
+
+    std::size_t size() const { return m_end - m_begin; }
+
+    std::size_t halo() const { return m_halo; }
+
+    std::size_t block() const { return m_block; }
+
+    // padded state, owned cell i starts at (halo + i) * block
+    std::vector<double> &data() { return m_data; }
+
+    const std::vector<double> &data() const { return m_data; }
+
+    double *owned() { return m_data.data() + m_halo * m_block; }
+
+    const double *owned() const { return m_data.data() + m_halo * m_block; }
+
+private:
+    friend class DecomposedDomain;
+
+    std::size_t m_begin{0};
+    std::size_t m_end{0};
+    std::size_t m_halo{0};
+    std::size_t m_block{1};
+    std::vector<double> m_data;
+
+    // double buffered by the parity of the exchange
+    std::vector<double> m_send_left[2];
+    std::vector<double> m_send_right[2];
+    unsigned m_parity{0};
+};
+
+// Partition of a periodic grid into one contiguous subdomain per thread of a
+// team. When there are fewer than `halo` cells per thread, only the first
+// `parts()` threads own cells; the others take part in the collective calls
+// with empty subdomains.
+class DecomposedDomain {
+public:
+    DecomposedDomain(ThreadTeam &team, std::size_t cells, std::size_t halo,
+                     std::size_t block)
+        : m_team(team), m_partition(cells, halo, team.size()), m_halo(halo),
+          m_block(block), m_sub(team.size()) {}
+
+    std::size_t cells() const { return m_partition.cells; }
+
+    std::size_t parts() const { return m_partition.parts; }
+
+    // a single subdomain must still hold a full halo of distinct cells
+    bool valid() const { return cells() >= std::max<std::size_t>(m_halo, 1); }
+
+    Subdomain &operator[](std::size_t tid) { return m_sub[tid]; }
+
+    // allocate the subdomain of thread tid, call it on that thread
+    Subdomain &allocate(std::size_t tid) {
+        auto [begin, end] = m_partition.range(tid);
+        m_sub[tid].allocate(begin, end, m_halo, m_block);
+        return m_sub[tid];
+    }
+
+    // fill the ghost cells of subdomain tid from its neighbours, collective
+    void exchange(std::size_t tid) {
+        auto &sub = m_sub[tid];
+        auto parity = sub.m_parity;
+        sub.m_parity ^= 1U;
+
+        const std::size_t width = m_halo * m_block;
+        const std::size_t n = sub.size() * m_block;
+        auto &data = sub.m_data;
+        if (tid < parts()) {
+            std::copy_n(data.begin() + offset(width), width,
+                        sub.m_send_left[parity].begin());
+            std::copy_n(data.begin() + offset(n), width,
+                        sub.m_send_right[parity].begin());
+        }
+
+        // double buffered: a send buffer is rewritten only after the next
+        // barrier, when both neighbours have read it
+        m_team.barrier();
+
+        if (tid < parts()) {
+            const auto &left = m_sub[m_partition.left(tid)];
+            const auto &right = m_sub[m_partition.right(tid)];
+            std::copy_n(left.m_send_right[parity].begin(), width, data.begin());
+            std::copy_n(right.m_send_left[parity].begin(), width,
+                        data.begin() + offset(width + n));
+        }
+    }
+
+private:
+    static std::ptrdiff_t offset(std::size_t i) {
+        return static_cast<std::ptrdiff_t>(i);
+    }
+
+    ThreadTeam &m_team;
+    Partition m_partition;
+    std::size_t m_halo;
+    std::size_t m_block;
+    std::vector<Subdomain> m_sub;
+};
+
+}  // namespace flux::parallel
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+
+namespace flux::parallel {
+
+// Contiguous split of the `cells` cells of a periodic grid into `parts`
+// slices, each holding at least `halo` cells so that the ghost cells of a
+// slice come from its two neighbours only. Workers numbered parts and above
+// own empty slices.
+struct Partition {
+    std::size_t cells;
+    std::size_t parts;
+
+    Partition(std::size_t n, std::size_t halo, std::size_t workers)
+        : cells(n),
+          parts(std::clamp<std::size_t>(n / std::max<std::size_t>(halo, 1), 1,
+                                        std::max<std::size_t>(workers, 1))) {}
+
+    // [begin, end) of worker p
+    std::pair<std::size_t, std::size_t> range(std::size_t p) const {
+        return {std::min(p, parts) * cells / parts,
+                std::min(p + 1, parts) * cells / parts};
+    }
+
+    std::size_t left(std::size_t p) const { return (p + parts - 1) % parts; }
+
+    std::size_t right(std::size_t p) const { return (p + 1) % parts; }
+};
+
+}  // namespace flux::parallel
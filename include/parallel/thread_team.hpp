@@ -0,0 +1,162 @@
+#pragma once
+
+#include <algorithm>
+#include <barrier>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace flux::parallel {
+
+// FLUX_NUM_THREADS if set, otherwise the number of hardware threads
+inline std::size_t default_thread_count() {
+    if (const char *env = std::getenv("FLUX_NUM_THREADS")) {
+        auto n = std::strtoul(env, nullptr, 10);
+        if (n > 0) return n;
+    }
+    return std::max(1U, std::thread::hardware_concurrency());
+}
+
+// Persistent team of worker threads for SPMD regions. With `pin`, thread k is
+// bound to the k-th CPU of the creating thread's affinity mask (round robin),
+// so memory it touches first stays on its NUMA node and the scheduler cannot
+// migrate it away. The creating thread itself is left unpinned and only waits
+// in run().
+class ThreadTeam {
+public:
+    explicit ThreadTeam(std::size_t size, bool pin = true)
+        : m_size(std::max<std::size_t>(size, 1)),
+          m_barrier(static_cast<std::ptrdiff_t>(m_size)), m_slots(m_size) {
+#if defined(__linux__)
+        cpu_set_t mask;
+        if (pin
+            && pthread_getaffinity_np(pthread_self(), sizeof(mask), &mask)
+                   == 0) {
+            for (std::size_t cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+                if (CPU_ISSET(cpu, &mask)) m_cpus.push_back(cpu);
+            }
+        }
+#endif
+        for (std::size_t tid = 0; tid < m_size; tid++) {
+            m_workers.emplace_back([this, tid]() { worker_loop(tid); });
+#if defined(__linux__)
+            pin_to(m_workers.back().native_handle(), tid);
+#endif
+        }
+    }
+
+    ThreadTeam(const ThreadTeam &) = delete;
+
+    ThreadTeam &operator=(const ThreadTeam &) = delete;
+
+    ~ThreadTeam() {
+        {
+            std::lock_guard lock(m_mutex);
+            m_stop = true;
+            m_generation++;
+        }
+        m_start.notify_all();
+        for (auto &w : m_workers) w.join();
+    }
+
+    std::size_t size() const { return m_size; }
+
+    // run func(tid) on every thread of the team, return when all are done
+    template <typename Func>
+    void run(Func &&func) {
+        {
+            std::lock_guard lock(m_mutex);
+            m_job = [&func](std::size_t tid) { func(tid); };
+            m_pending = m_size;
+            m_generation++;
+        }
+        m_start.notify_all();
+
+        std::unique_lock lock(m_mutex);
+        m_done.wait(lock, [this]() { return m_pending == 0; });
+        m_job = nullptr;
+    }
+
+    // wait for all threads of the team, only inside run
+    void barrier() { m_barrier.arrive_and_wait(); }
+
+    // max of `value` over the team, only inside run
+    double reduce_max(std::size_t tid, double value) {
+        auto &slot = m_slots[tid];
+        auto parity = slot.parity;
+        slot.value[parity] = value;
+        slot.parity ^= 1U;
+
+        // double buffered: a slot is rewritten only after the next barrier,
+        // when every thread has read it
+        barrier();
+
+        double result = value;
+        for (const auto &s : m_slots) {
+            result = std::max(result, s.value[parity]);
+        }
+        return result;
+    }
+
+private:
+    struct alignas(64) Slot {
+        double value[2]{0, 0};
+        unsigned parity{0};
+    };
+
+    void worker_loop(std::size_t tid) {
+        std::size_t seen = 0;
+        for (;;) {
+            std::function<void(std::size_t)> job;
+            {
+                std::unique_lock lock(m_mutex);
+                m_start.wait(lock, [&]() { return m_generation != seen; });
+                seen = m_generation;
+                if (m_stop) return;
+                job = m_job;
+            }
+
+            job(tid);
+
+            std::lock_guard lock(m_mutex);
+            if (--m_pending == 0) m_done.notify_one();
+        }
+    }
+
+#if defined(__linux__)
+    void pin_to(pthread_t thread, std::size_t tid) const {
+        if (m_cpus.empty()) return;
+
+        cpu_set_t mask;
+        CPU_ZERO(&mask);
+        CPU_SET(m_cpus[tid % m_cpus.size()], &mask);
+        pthread_setaffinity_np(thread, sizeof(mask), &mask);
+    }
+
+    std::vector<std::size_t> m_cpus;  // empty unless pinning
+#endif
+
+    std::size_t m_size;
+    std::barrier<> m_barrier;
+    std::vector<Slot> m_slots;
+
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_start;
+    std::condition_variable m_done;
+    std::function<void(std::size_t)> m_job;
+    std::size_t m_pending{0};
+    std::size_t m_generation{0};
+    bool m_stop{false};
+};
+
+}  // namespace flux::parallel
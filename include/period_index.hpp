@@ -1,6 +1,9 @@
 #pragma once
 
 #include <cstddef>
+#include <span>
+#include <vector>
+
 namespace flux {
 class PeriodIndex {
 public:
@@ -20,4 +23,38 @@ private:
     size_t m_n{0};
     size_t m_i{0};
 };
+
+// copy u with `halo` periodic ghost cells on each side into result, every
+// cell holds `block` values; result keeps its storage if it is large enough
+template <typename T>
+inline void pad_periodic(const std::vector<T> &u, size_t halo, size_t block,
+                         std::vector<T> &result) {
+    size_t n = u.size() / block;
+    result.resize((n + 2 * halo) * block);
+    for (size_t k = 0; k < n + 2 * halo; k++) {
+        size_t src = (k + n * (halo / n + 1) - halo) % n;
+        for (size_t j = 0; j < block; j++) {
+            result[k * block + j] = u[src * block + j];
+        }
+    }
+}
+
+template <typename T>
+inline std::vector<T> pad_periodic(const std::vector<T> &u, size_t halo,
+                                   size_t block) {
+    auto result = std::vector<T>{};
+    pad_periodic(u, halo, block, result);
+    return result;
+}
+
+// fill the `halo` ghost cells on each side of the padded buffer u from its
+// cells, one value per cell, for traces computed in place
+template <typename T>
+inline void fill_periodic_halo(std::span<T> u, size_t halo) {
+    size_t n = u.size() - 2 * halo;
+    for (size_t k = 0; k < halo; k++) {
+        u[k] = u[halo + (k + n * (halo / n + 1) - halo) % n];
+        u[halo + n + k] = u[halo + k % n];
+    }
+}
 }  // namespace flux
@@ -0,0 +1,203 @@
+#pragma once
+
+// Batched projections of a function onto the cells of a uniform 1d mesh, and
+// the error of a modal state against a function.
+//
+// The function is evaluated at the Gauss points of a block of cells at once,
+// one point after the other over contiguous cells, so the loops vectorize
+// when the function does and the function inlines. The values are reduced
+// with a table of the Gauss weights times the basis at the points (times the
+// inverse mass), so no basis is evaluated per cell. Meshes of more than
+// projection_cells_per_thread cells per thread are split over threads
+// (threads = 0: FLUX_NUM_THREADS or the hardware threads), func must then be
+// safe to call concurrently; cells are independent, so the result does not
+// depend on the number of threads.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "error_and_order.hpp"
+#include "legendre_polys.hpp"
+#include "parallel/thread_team.hpp"
+
+#include "gaussquad/gaussquad.hpp"
+
+namespace flux {
+
+namespace detail {
+
+inline constexpr std::size_t projection_block = 256;
+
+// no thread for fewer cells
+inline constexpr std::size_t projection_cells_per_thread = 1 << 14;
+
+// out[i * rows + r] = sum_g table[r * points + g] func(x[i] + offsets[g])
+// for the cells i in [first, last)
+template <typename Func>
+void project_cells(const Func &func, const std::vector<double> &x,
+                   const std::vector<double> &offsets,
+                   const std::vector<double> &table, std::size_t rows,
+                   std::vector<double> &out, std::size_t first,
+                   std::size_t last) {
+    constexpr std::size_t block = projection_block;
+    const std::size_t points = offsets.size();
+    auto values = std::vector<double>(points * block);
+    auto acc = std::vector<double>(rows * block);
+
+    for (std::size_t begin = first; begin < last; begin += block) {
+        const std::size_t len = std::min(block, last - begin);
+        const double *xb = x.data() + begin;
+
+        for (std::size_t g = 0; g < points; g++) {
+            const double offset = offsets[g];
+            double *v = values.data() + g * block;
+            for (std::size_t i = 0; i < len; i++) v[i] = func(xb[i] + offset);
+        }
+
+        for (std::size_t r = 0; r < rows; r++) {
+            double *a = acc.data() + r * block;
+            std::fill(a, a + len, 0.0);
+            for (std::size_t g = 0; g < points; g++) {
+                const double c = table[r * points + g];
+                const double *v = values.data() + g * block;
+                for (std::size_t i = 0; i < len; i++) a[i] += c * v[i];
+            }
+        }
+
+        for (std::size_t i = 0; i < len; i++) {
+            for (std::size_t r = 0; r < rows; r++) {
+                out[(begin + i) * rows + r] = acc[r * block + i];
+            }
+        }
+    }
+}
+
+// project_cells over all cells, split into contiguous ranges over at most
+// `threads` threads
+template <typename Func>
+std::vector<double> project(const Func &func, const std::vector<double> &x,
+                            const std::vector<double> &offsets,
+                            const std::vector<double> &table, std::size_t rows,
+                            std::size_t threads) {
+    const std::size_t n = x.size();
+    auto out = std::vector<double>(n * rows);
+    if (threads == 0) threads = parallel::default_thread_count();
+    threads = std::clamp<std::size_t>(
+        threads, 1, std::max<std::size_t>(n / projection_cells_per_thread, 1));
+    if (threads == 1) {
+        project_cells(func, x, offsets, table, rows, out, 0, n);
+        return out;
+    }
+
+    auto pool = std::vector<std::jthread>{};
+    for (std::size_t t = 0; t < threads; t++) {
+        pool.emplace_back([&, t]() {
+            project_cells(func, x, offsets, table, rows, out, n * t / threads,
+                          n * (t + 1) / threads);
+        });
+    }
+    pool.clear();
+    return out;
+}
+
+}  // namespace detail
+
+// averages of func over the cells [x_i - dx/2, x_i + dx/2] by the Gauss rule
+// of gauss_k points
+template <typename Func>
+std::vector<double> cell_averages(const Func &func,
+                                  const std::vector<double> &x, double dx,
+                                  std::size_t gauss_k,
+                                  std::size_t threads = 0) {
+    auto [points, weights] =
+        gaussquad::gausslegendre(static_cast<unsigned>(gauss_k));
+
+    auto offsets = std::vector<double>(gauss_k);
+    auto table = std::vector<double>(gauss_k);
+    for (std::size_t g = 0; g < gauss_k; g++) {
+        offsets[g] = points[g] * dx / 2;
+        table[g] = weights[g] / 2;
+    }
+    return detail::project(func, x, offsets, table, 1, threads);
+}
+
+// modal coefficients of the L2 projection of func onto the Legendre
+// polynomials Poly_0, ..., Poly_DG_k of each cell, (DG_k + 1) per cell as in
+// the DG state
+template <typename Poly = LegendrePolys, typename Func>
+std::vector<double> modal_projection(const Func &func,
+                                     const std::vector<double> &x, double dx,
+                                     std::size_t DG_k, std::size_t gauss_k,
+                                     std::size_t threads = 0) {
+    auto [points, weights] =
+        gaussquad::gausslegendre(static_cast<unsigned>(gauss_k));
+
+    const std::size_t rows = DG_k + 1;
+    auto offsets = std::vector<double>(gauss_k);
+    auto table = std::vector<double>(rows * gauss_k);
+    for (std::size_t g = 0; g < gauss_k; g++) {
+        offsets[g] = points[g] * dx / 2;
+        for (std::size_t j = 0; j < rows; j++) {
+            table[j * gauss_k + g] = weights[g] * Poly::eval(j, points[g])
+                                     * static_cast<double>(2 * j + 1) / 2;
+        }
+    }
+    return detail::project(func, x, offsets, table, rows, threads);
+}
+
+// L1, L2 and Linf norms of the error of the modal state uh against exact at
+// the Gauss points, as DG_error of the DG tests in one pass: the basis at the
+// points is tabled and the sums are pairwise (error_norms)
+template <typename Poly = LegendrePolys, typename Func>
+ErrorNorms modal_error_norms(const std::vector<double> &uh, const Func &exact,
+                             const std::vector<double> &x, double dx,
+                             std::size_t DG_k, std::size_t gauss_k,
+                             std::size_t threads = 0) {
+    auto [points, weights] =
+        gaussquad::gausslegendre(static_cast<unsigned>(gauss_k));
+
+    const std::size_t n = x.size();
+    const std::size_t rows = DG_k + 1;
+    if (uh.size() != n * rows) {
+        std::cerr << "modal_error_norms: uh has not (DG_k + 1) values per cell"
+                  << std::endl;
+        exit(1);
+    }
+
+    auto offsets = std::vector<double>(gauss_k);
+    auto basis = std::vector<double>(gauss_k * rows);
+    for (std::size_t g = 0; g < gauss_k; g++) {
+        offsets[g] = points[g] * dx / 2;
+        for (std::size_t j = 0; j < rows; j++) {
+            basis[g * rows + j] = Poly::eval(j, points[g]);
+        }
+    }
+
+    auto block_sums = [&](std::size_t b) {
+        const std::size_t first = b * detail::norm_block;
+        const std::size_t last = std::min(first + detail::norm_block, n);
+        auto sums = detail::NormSums{};
+        for (std::size_t i = first; i < last; i++) {
+            const double *u = uh.data() + i * rows;
+            for (std::size_t g = 0; g < gauss_k; g++) {
+                const double *p = basis.data() + g * rows;
+                double value = 0;
+                for (std::size_t j = 0; j < rows; j++) value += u[j] * p[j];
+                double e = std::abs(value - exact(x[i] + offsets[g]));
+                sums.l1 += weights[g] * e;
+                sums.l2 += weights[g] * e * e;
+                sums.linf = std::max(sums.linf, e);
+            }
+        }
+        return sums;
+    };
+
+    auto sums = detail::block_norm_sums(block_sums, n, threads);
+    return {sums.l1 * dx / 2, std::sqrt(sums.l2 * dx / 2), sums.linf};
+}
+
+}  // namespace flux
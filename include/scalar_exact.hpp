@@ -0,0 +1,59 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+#include "flux_policy.hpp"
+
+namespace flux {
+
+// scalar law u_t + f(u)_x = 0 with flux policy F
+// u0 periodic on [xl, xr]
+// smooth solution u(x, t) = u0(x0), x = x0 + f'(u0(x0)) t, valid before the
+// characteristics cross
+template <FluxPolicy F>
+class ScalarExact {
+public:
+    ScalarExact(std::function<double(double)> u0, double xl, double xr,
+                double ep = 1e-14)
+        : m_u0(std::move(u0)), m_ep(ep) {
+        // range of f'(u0), bracketing the foot x0 of the characteristic
+        const std::size_t samples = 4096;
+        m_speed_min = F::df(m_u0(xl));
+        m_speed_max = m_speed_min;
+        for (std::size_t i = 1; i < samples; i++) {
+            double x = xl + (xr - xl) * static_cast<double>(i) / samples;
+            double s = F::df(m_u0(x));
+            m_speed_min = std::min(m_speed_min, s);
+            m_speed_max = std::max(m_speed_max, s);
+        }
+    }
+
+    double init_value(double x) const { return m_u0(x); }
+
+    double eval(double x, double t) const {
+        // G(x0) = x0 + f'(u0(x0)) t - x is increasing, bisection
+        double a = x - m_speed_max * t;
+        double b = x - m_speed_min * t;
+        while (b - a > m_ep * (1 + std::abs(x))) {
+            double c = (a + b) / 2;
+            if (c + F::df(m_u0(c)) * t - x < 0) {
+                a = c;
+            }
+            else {
+                b = c;
+            }
+        }
+        return m_u0((a + b) / 2);
+    }
+
+private:
+    std::function<double(double)> m_u0;
+    double m_ep;
+    double m_speed_min{0};
+    double m_speed_max{0};
+};
+
+}  // namespace flux
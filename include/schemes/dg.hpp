@@ -0,0 +1,197 @@
+#pragma once
+
+#include <cmath>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "gauss_rule.hpp"
+#include "legendre_polys.hpp"
+#include "limiter.hpp"
+#include "numerical_flux.hpp"
+#include "period_index.hpp"
+#include "scratch_arena.hpp"
+#include "solver/preset.hpp"
+#include "stencil.hpp"
+
+namespace flux::schemes {
+// DG-RK3 for the scalar law F with Legendre basis, framework independent.
+// The state stores DG_k + 1 modal coefficients per cell.
+// The kernels work on a slice padded with `halo` ghost cells on each side
+// (see solver_threads.hpp); the periodic get_dt/op_L pad the whole state.
+template <FluxPolicy F>
+class BasicDG {
+public:
+    static constexpr bool rk3 = true;
+    using mesh_type = Mesh1d;
+
+    static constexpr size_t halo = 1;
+    static constexpr bool stage_speed = false;  // op_L needs no global speed
+
+    BasicDG(size_t DG_k, size_t gauss_k) : m_DG_k(DG_k), m_gauss_k(gauss_k) {}
+
+    size_t DG_k() const { return m_DG_k; }
+
+    size_t block(const Mesh1d &ex) const { return m_DG_k + 1; }
+
+    // max |f'(u)| at the cell centers of cells [first, last)
+    double max_speed(const std::vector<double> &u, const Mesh1d &ex,
+                     size_t first, size_t last) const {
+        using P = LegendrePolys;
+
+        double df_max = 0;
+        for (size_t i = first; i < last; i++) {
+            double tmp = std::abs(
+                F::df(evals<P>(u, 0, i * (m_DG_k + 1), m_DG_k + 1)));
+            if (tmp > df_max) df_max = tmp;
+        }
+        return df_max;
+    }
+
+    double dt(double df_max, const Mesh1d &ex) const {
+        auto coeff = static_cast<double>(2 * m_DG_k + 1);  // DG CFL
+
+        if (m_DG_k > 2) {
+            return pow(ex.dx, static_cast<double>(m_DG_k + 1) / 3)
+                   / (coeff * df_max);
+        }
+        return ex.dx / (coeff * df_max);
+    }
+
+    // L of the owned cells [first, last) of the padded slice u
+    void op_L(const std::vector<double> &u, double df_max, const Mesh1d &ex,
+              std::vector<double> &L, size_t first, size_t last) const {
+        using P = LegendrePolys;
+        using Px = LegendrePolysDx;
+        size_t m = last - first;
+        auto &arena = scratch_arena();
+        auto frame = arena.frame();
+
+        // traces of cells first - 1, ..., last
+        auto ul = arena.take(m + 2);
+        auto ur = arena.take(m + 2);
+        for (size_t k = 0; k < m + 2; k++) {
+            size_t c = first + k + halo - 1;
+            ul[k] = evals<P>(u, -1, c * (m_DG_k + 1), m_DG_k + 1);
+            ur[k] = evals<P>(u, 1, c * (m_DG_k + 1), m_DG_k + 1);
+        }
+
+        auto fhat_l = arena.take(m);
+        auto fhat_r = arena.take(m);
+
+        // the flux at the left face of cell k gathers ur of cell k - 1
+        for (size_t k = 0; k < m; k++) {
+            auto r = Stencil<1, 0>(ur, k + 1);
+            auto l = Stencil<0, 1>(ul, k + 1);
+            fhat_l[k] = fhat_LF<F>(r[-1], l[0]);
+            fhat_r[k] = fhat_LF<F>(r[0], l[1]);
+        }
+
+        const auto &[gauss_points, gauss_weights] = gauss_rule(m_gauss_k);
+
+        for (size_t k = 0; k < m; k++) {
+            size_t i = first + k;
+            size_t c = i + halo;
+            for (size_t j = 0; j <= m_DG_k; j++) {
+                double tmp_sum = 0;
+                for (size_t gauss_i = 0; gauss_i < m_gauss_k; gauss_i++) {
+                    double tmp1 = evals<P>(u, gauss_points[gauss_i],
+                                           c * (m_DG_k + 1), m_DG_k + 1);
+                    double tmp2 = F::f(tmp1);
+                    double tmp3 =
+                        Px::eval(j, gauss_points[gauss_i]) * (2 / ex.dx);
+                    tmp_sum += gauss_weights[gauss_i] * tmp2 * tmp3;
+                }
+                double Fu = tmp_sum * (ex.dx / 2);
+                double bl = fhat_l[k] * P::eval(j, -1);
+                double br = fhat_r[k] * P::eval(j, 1);
+
+                double inner_inv = static_cast<double>(2 * j + 1) / ex.dx;
+
+                L[i * (m_DG_k + 1) + j] = inner_inv * (Fu - br + bl);
+            }
+        }
+    }
+
+    // whether post_process_rk_stage changes the state
+    bool stage_limiter() const { return m_tvb_M >= 0; }
+
+    // TVB limiter of the owned cells [first, last) of the padded slice u
+    void post_process_rk_stage(const std::vector<double> &u, const Mesh1d &ex,
+                               std::vector<double> &u2, size_t first,
+                               size_t last) const {
+        using P = LegendrePolys;
+        size_t m = last - first;
+        auto &arena = scratch_arena();
+        auto frame = arena.frame();
+
+        auto u_mean = arena.take(m + 2);  // cells first - 1, ..., last
+        for (size_t k = 0; k < m + 2; k++) {
+            u_mean[k] = u[(first + k + halo - 1) * (m_DG_k + 1)];
+        }
+
+        auto limiter = Limiter{m_tvb_M * ex.dx * ex.dx};  // add limiter
+
+        for (size_t k = 0; k < m; k++) {
+            size_t i = first + k;
+            size_t c = i + halo;
+            for (size_t j = 0; j <= m_DG_k; j++) {
+                u2[i * (m_DG_k + 1) + j] = u[c * (m_DG_k + 1) + j];
+            }
+
+            double ret_ul = evals<P>(u, -1, c * (m_DG_k + 1), m_DG_k + 1);
+            double ret_ur = evals<P>(u, 1, c * (m_DG_k + 1), m_DG_k + 1);
+            auto s = Stencil<1, 1>(u_mean, k + 1);
+            limiter.minmod(ret_ul, ret_ur, s[-1], s[0], s[1]);
+
+            Limiter::DG_recover(u2, i * (m_DG_k + 1), m_DG_k, s[0], ret_ul,
+                                ret_ur);
+        }
+    }
+
+    double get_dt(const Vec &var, Mesh1d &ex, double t) const {
+        size_t cell_num = var.data.size() / (m_DG_k + 1);
+        return dt(max_speed(var.data, ex, 0, cell_num), ex);
+    }
+
+    Vec op_L(const Vec &var, Mesh1d &ex, double t) const {
+        size_t cell_num = var.data.size() / (m_DG_k + 1);
+        auto &arena = scratch_arena();
+        auto frame = arena.frame();
+        auto &u = arena.vector(var.data.size() + 2 * halo * (m_DG_k + 1));
+        pad_periodic(var.data, halo, m_DG_k + 1, u);
+
+        auto L = std::vector<double>(var.data.size());
+        op_L(u, 0, ex, L, 0, cell_num);
+        return Vec{std::move(L)};
+    }
+
+    // TVB limiter, disabled when tvb_M < 0
+    Vec post_process_rk_stage(const Vec &var, Mesh1d &ex, double t) const {
+        if (m_tvb_M < 0) return var;
+
+        auto &arena = scratch_arena();
+        auto frame = arena.frame();
+        auto &u = arena.vector(var.data.size() + 2 * halo * (m_DG_k + 1));
+        pad_periodic(var.data, halo, m_DG_k + 1, u);
+
+        auto u2 = std::vector<double>(var.data.size());
+        post_process_rk_stage(u, ex, u2, 0, var.data.size() / (m_DG_k + 1));
+        return Vec{std::move(u2)};
+    }
+
+    BasicDG &set_limiter(double tvb_M) {
+        m_tvb_M = tvb_M;
+        return *this;
+    }
+
+    auto cache_key() const { return std::tuple{m_DG_k, m_gauss_k, m_tvb_M}; }
+
+private:
+    size_t m_DG_k;
+    size_t m_gauss_k;
+    double m_tvb_M{-1};
+};
+
+using DG = BasicDG<Burgers>;
+}  // namespace flux::schemes
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <tuple>
+#include <vector>
+
+#include "euler.hpp"
+#include "solver/preset.hpp"
+#include "system_vec.hpp"
+#include "weno5.hpp"
+
+namespace flux::schemes {
+// FV-RK3-WENO5 for the 1d Euler equations on a periodic grid, framework
+// independent. The state layout L and the Riemann solver are compile-time
+// choices. With `characteristic` the reconstruction works on the
+// characteristic variables of the Roe average at each face, otherwise
+// component by component on the conserved variables.
+//
+// op_L makes three passes over arrays of layout L (timed one by one in
+// bench_euler_layout):
+//   reconstruct  traces ul, ur of the cells -1, ..., n
+//   riemann      fluxes F at the faces 0, ..., n, face i left of cell i
+//   difference   L_i = (F_i - F_{i+1}) / dx
+template <Layout L, euler::RiemannSolver Riemann = euler::HLLC>
+struct EulerFVWENO5 {
+    using var_type = SystemVec<3, L>;
+    using mesh_type = Mesh1d;
+
+    static constexpr size_t halo = 3;
+
+    bool characteristic = true;
+
+    auto cache_key() const { return std::tuple{characteristic}; }
+
+    // max |u| + c over all cells
+    double max_speed(const var_type &u) const {
+        double s_max = 0;
+        for (size_t i = 0; i < u.cells(); i++) {
+            double tmp = euler::max_speed(u.get(i));
+            if (tmp > s_max) s_max = tmp;
+        }
+        return s_max;
+    }
+
+    double get_dt(const var_type &var, Mesh1d &ex, double t) const {
+        return std::pow(ex.dx, 5.0 / 3) / (2 * max_speed(var));
+    }
+
+    var_type op_L(const var_type &var, Mesh1d &ex, double t) const {
+        size_t n = var.cells();
+        auto ul = var_type(std::vector<double>(3 * (n + 2)));
+        auto ur = var_type(std::vector<double>(3 * (n + 2)));
+        auto F = var_type(std::vector<double>(3 * (n + 1)));
+
+        reconstruct(pad_periodic(var, halo), ul, ur);
+        riemann(ul, ur, F);
+
+        auto result = var_type(std::vector<double>(3 * n));
+        for (size_t c = 0; c < 3; c++) {
+            for (size_t i = 0; i < n; i++) {
+                result.at(i, c) = (F.at(i, c) - F.at(i + 1, c)) / ex.dx;
+            }
+        }
+        return result;
+    }
+
+    // traces of the cells -1, ..., n from u padded with halo ghost cells,
+    // trace k belongs to the padded cell k + 2
+    void reconstruct(const var_type &u, var_type &ul, var_type &ur) const {
+        if (characteristic) {
+            reconstruct_characteristic(u, ul, ur);
+        }
+        else {
+            reconstruct_conserved(u, ul, ur);
+        }
+    }
+
+    // walks each component with the compile-time stride of the layout
+    static void reconstruct_conserved(const var_type &u, var_type &ul,
+                                      var_type &ur) {
+        constexpr size_t s = var_type::stride;
+        const size_t m = ul.cells();
+        for (size_t c = 0; c < 3; c++) {
+            const double *uc = u.component(c);
+            double *ul_c = ul.component(c);
+            double *ur_c = ur.component(c);
+            for (size_t k = 0; k < m; k++) {
+                weno5_point(uc[k * s], uc[(k + 1) * s], uc[(k + 2) * s],
+                            uc[(k + 3) * s], uc[(k + 4) * s], ul_c[k * s],
+                            ur_c[k * s]);
+            }
+        }
+    }
+
+    // face f, between the padded cells f + 2 and f + 3, projects its stencil
+    // f, ..., f + 5 onto the eigenvectors of the Roe average, so only the
+    // traces next to a face are set: ur of 0, ..., n and ul of 1, ..., n + 1
+    static void reconstruct_characteristic(const var_type &u, var_type &ul,
+                                           var_type &ur) {
+        const size_t faces = ul.cells() - 1;
+        for (size_t f = 0; f < faces; f++) {
+            auto e = euler::roe_eigensystem(u.get(f + 2), u.get(f + 3));
+
+            std::array<euler::State, 6> w{};
+            for (size_t s = 0; s < 6; s++) {
+                w[s] = e.to_characteristic(u.get(f + s));
+            }
+
+            euler::State w_m{};
+            euler::State w_p{};
+            for (size_t k = 0; k < 3; k++) {
+                double tmp = 0;
+                weno5_point(w[0][k], w[1][k], w[2][k], w[3][k], w[4][k], tmp,
+                            w_m[k]);
+                weno5_point(w[1][k], w[2][k], w[3][k], w[4][k], w[5][k],
+                            w_p[k], tmp);
+            }
+            ur.set(f, e.from_characteristic(w_m));
+            ul.set(f + 1, e.from_characteristic(w_p));
+        }
+    }
+
+    static void riemann(const var_type &ul, const var_type &ur, var_type &F) {
+        constexpr size_t s = var_type::stride;
+        // left state of face f is ur of trace f, right state ul of f + 1
+        std::array<const double *, 3> l{};
+        std::array<const double *, 3> r{};
+        std::array<double *, 3> out{};
+        for (size_t c = 0; c < 3; c++) {
+            l[c] = ur.component(c);
+            r[c] = ul.component(c) + s;
+            out[c] = F.component(c);
+        }
+        for (size_t f = 0; f < F.cells(); f++) {
+            euler::State UL = {l[0][f * s], l[1][f * s], l[2][f * s]};
+            euler::State UR = {r[0][f * s], r[1][f * s], r[2][f * s]};
+            auto flux = Riemann::flux(UL, UR);
+            for (size_t c = 0; c < 3; c++) out[c][f * s] = flux[c];
+        }
+    }
+};
+}  // namespace flux::schemes
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "flux_policy.hpp"
+#include "period_index.hpp"
+#include "scratch_arena.hpp"
+#include "solver/preset.hpp"
+#include "stencil.hpp"
+#include "weno5.hpp"
+
+namespace flux::schemes {
+// FD-RK3-WENO5 with global Lax-Friedrichs splitting for the scalar law F,
+// framework independent.
+// The kernels work on a slice padded with `halo` ghost cells on each side
+// (see solver_threads.hpp); the periodic get_dt/op_L pad the whole state.
+template <FluxPolicy F>
+struct BasicFDWENO5 {
+    static constexpr bool rk3 = true;
+    using mesh_type = Mesh1d;
+
+    static constexpr size_t halo = 3;
+    static constexpr bool stage_speed = true;  // splitting uses global max |f'|
+
+    size_t block(const Mesh1d &ex) const { return 1; }
+
+    // max |f'(u)| over cells [first, last)
+    double max_speed(const std::vector<double> &u, const Mesh1d &ex,
+                     size_t first, size_t last) const {
+        double df_max = 0;
+        for (size_t i = first; i < last; i++) {
+            double tmp = std::abs(F::df(u[i]));
+            if (tmp > df_max) df_max = tmp;
+        }
+        return df_max;
+    }
+
+    double dt(double df_max, const Mesh1d &ex) const {
+        return std::pow(ex.dx, 5.0 / 3) / (2 * df_max);
+    }
+
+    // L of the owned cells [first, last) of the padded slice u,
+    // lf_c is the global max |f'(u)|
+    void op_L(const std::vector<double> &u, double lf_c, const Mesh1d &ex,
+              std::vector<double> &L, size_t first, size_t last) const {
+        size_t m = last - first;
+        auto &arena = scratch_arena();
+        auto frame = arena.frame();
+
+        // split, padded cells first - 3 + halo, ..., last + 2 + halo
+        auto fplus = [lf_c](double v) { return 0.5 * (F::f(v) + lf_c * v); };
+        auto fminus = [lf_c](double v) { return 0.5 * (F::f(v) - lf_c * v); };
+        size_t base = first + halo - 3;
+        auto fu_plus = arena.take(m + 6);
+        auto fu_minus = arena.take(m + 6);
+        for (size_t k = 0; k < m + 6; k++) {
+            fu_plus[k] = fplus(u[base + k]);
+            fu_minus[k] = fminus(u[base + k]);
+        }
+
+        // reconstruction of cells first - 1, ..., last
+        auto fplus_r = arena.take(m + 2);
+        auto fminus_l = arena.take(m + 2);
+        for (size_t k = 0; k < m + 2; k++) {
+            double useless = 0;
+            weno5_point(Stencil<2, 2>(fu_plus, k + 2), useless, fplus_r[k]);
+            weno5_point(Stencil<2, 2>(fu_minus, k + 2), fminus_l[k], useless);
+        }
+
+        for (size_t k = 0; k < m; k++) {
+            auto r = Stencil<1, 0>(fplus_r, k + 1);
+            auto l = Stencil<0, 1>(fminus_l, k + 1);
+            double fhat_l = r[-1] + l[0];
+            double fhat_r = r[0] + l[1];
+            L[first + k] = (fhat_l - fhat_r) / ex.dx;
+        }
+    }
+
+    double get_dt(const Vec &var, Mesh1d &ex, double t) const {
+        return dt(max_speed(var.data, ex, 0, var.data.size()), ex);
+    }
+
+    Vec op_L(const Vec &var, Mesh1d &ex, double t) const {
+        size_t n = var.data.size();
+        auto &arena = scratch_arena();
+        auto frame = arena.frame();
+        auto &u = arena.vector(n + 2 * halo);
+        pad_periodic(var.data, halo, 1, u);
+
+        auto L = std::vector<double>(n);
+        op_L(u, max_speed(var.data, ex, 0, n), ex, L, 0, n);
+        return Vec{std::move(L)};
+    }
+};
+
+using FDWENO5 = BasicFDWENO5<Burgers>;
+}  // namespace flux::schemes
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <tuple>
+#include <vector>
+
+#include "numerical_flux.hpp"
+#include "schemes/sweep2d.hpp"
+#include "solver/preset.hpp"
+
+namespace flux::schemes {
+// 2d FV-Euler-Godunov for u_t + f(u)_x + f(u)_y = 0 with the scalar law F,
+// dimension by dimension, framework independent.
+// The kernels work on slabs of rows padded with `halo` ghost rows on each
+// side (see subdomain_scheme.hpp), a row is one cell of block(ex) = nx.
+template <FluxPolicy F>
+struct BasicFV2dGodunov {
+    using mesh_type = Mesh2d;
+
+    static constexpr bool rk3 = false;
+    static constexpr size_t halo = 1;
+    static constexpr bool stage_speed = false;  // op_L needs no global speed
+
+    std::size_t tile{256};  // columns per strip of the y-sweep
+
+    auto cache_key() const { return std::tuple{tile}; }
+
+    size_t block(const Mesh2d &ex) const { return ex.nx; }
+
+    // max |f'(u)| over rows [first, last)
+    double max_speed(const std::vector<double> &u, const Mesh2d &ex,
+                     size_t first, size_t last) const {
+        double df_max = 0;
+        for (size_t k = first * ex.nx; k < last * ex.nx; k++) {
+            double tmp = std::abs(F::df(u[k]));
+            if (tmp > df_max) df_max = tmp;
+        }
+        return df_max;
+    }
+
+    double dt(double df_max, const Mesh2d &ex) const {
+        return 0.5 / (df_max / ex.dx + df_max / ex.dy);
+    }
+
+    // L of the owned rows [first, last) of the padded slab u
+    void op_L(const std::vector<double> &u, double df_max, const Mesh2d &ex,
+              std::vector<double> &L, size_t first, size_t last) const {
+        sweep_x<0>(u.data() + (first + halo) * ex.nx, L.data() + first * ex.nx,
+                   ex.nx, last - first, ex.dx, rec, fhat);
+        sweep_y<0>(padded_rows(u, ex, halo), L.data(), ex.nx, first, last,
+                   ex.dy, tile, rec, fhat);
+    }
+
+    double get_dt(const Vec &var, Mesh2d &ex, double t) const {
+        return dt(max_speed(var.data, ex, 0, ex.ny), ex);
+    }
+
+    Vec op_L(const Vec &var, Mesh2d &ex, double t) const {
+        const auto &u = var.data;
+        auto L = std::vector<double>(u.size());
+
+        sweep_x<0>(u.data(), L.data(), ex.nx, ex.ny, ex.dx, rec, fhat);
+        sweep_y<0>(periodic_rows(u, ex), L.data(), ex.nx, 0, ex.ny, ex.dy,
+                   tile, rec, fhat);
+        return Vec{L};
+    }
+
+private:
+    static void rec(const std::array<const double *, 1> &s, std::size_t c,
+                    double &ul, double &ur) {
+        ul = ur = s[0][c];
+    }
+
+    static double fhat(double ul, double ur) { return fhat_godunov<F>(ul, ur); }
+};
+
+using FV2dGodunov = BasicFV2dGodunov<Burgers>;
+}  // namespace flux::schemes
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "numerical_flux.hpp"
+#include "period_index.hpp"
+#include "scratch_arena.hpp"
+#include "solver/preset.hpp"
+#include "stencil.hpp"
+
+namespace flux::schemes {
+// FV-Euler-Godunov for the scalar law F, framework independent.
+// The kernels work on a slice padded with `halo` ghost cells on each side
+// (see solver_threads.hpp); the periodic get_dt/op_L pad the whole state.
+template <FluxPolicy F>
+struct BasicFVGodunov {
+    static constexpr bool rk3 = false;
+    using mesh_type = Mesh1d;
+
+    static constexpr size_t halo = 1;
+    static constexpr bool stage_speed = false;  // op_L needs no global speed
+
+    size_t block(const Mesh1d &ex) const { return 1; }
+
+    // max |f'(u)| over cells [first, last)
+    double max_speed(const std::vector<double> &u, const Mesh1d &ex,
+                     size_t first, size_t last) const {
+        double df_max = 0;
+        for (size_t i = first; i < last; i++) {
+            double tmp = std::abs(F::df(u[i]));
+            if (tmp > df_max) df_max = tmp;
+        }
+        return df_max;
+    }
+
+    double dt(double df_max, const Mesh1d &ex) const {
+        return 0.5 * (ex.dx) / df_max;
+    }
+
+    // L of the owned cells [first, last) of the padded slice u
+    void op_L(const std::vector<double> &u, double df_max, const Mesh1d &ex,
+              std::vector<double> &L, size_t first, size_t last) const {
+        for (size_t i = first; i < last; i++) {
+            auto s = Stencil<1, 1>(u, i + halo);
+            double fhat_l = fhat_godunov<F>(s[-1], s[0]);
+            double fhat_r = fhat_godunov<F>(s[0], s[1]);
+            L[i] = (fhat_l - fhat_r) / (ex.dx);
+        }
+    }
+
+    // numerical flux at the left face of owned cell i of the padded slice u,
+    // i in [0, n]
+    double face_flux(const std::vector<double> &u, double df_max,
+                     size_t i) const {
+        auto s = Stencil<1, 0>(u, i + halo);
+        return fhat_godunov<F>(s[-1], s[0]);
+    }
+
+    double get_dt(const Vec &var, Mesh1d &ex, double t) const {
+        return dt(max_speed(var.data, ex, 0, var.data.size()), ex);
+    }
+
+    Vec op_L(const Vec &var, Mesh1d &ex, double t) const {
+        size_t n = var.data.size();
+        auto &arena = scratch_arena<double>();
+        auto frame = arena.frame();
+        auto &u = arena.vector(n + 2 * halo);
+        pad_periodic(var.data, halo, 1, u);
+
+        auto L = std::vector<double>(n);
+        op_L(u, 0, ex, L, 0, n);
+        return Vec{std::move(L)};
+    }
+};
+
+using FVGodunov = BasicFVGodunov<Burgers>;
+}  // namespace flux::schemes
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "numerical_flux.hpp"
+#include "period_index.hpp"
+#include "scratch_arena.hpp"
+#include "solver/preset.hpp"
+#include "stencil.hpp"
+#include "weno.hpp"
+
+namespace flux::schemes {
+// FV-RK3-WENO of order 2R - 1 for the scalar law F, framework independent,
+// with the same kernel interface as BasicFVWENO5 (halo = R ghost cells).
+// dt ~ dx^{(2R-1)/3} keeps the RK3 error at the order of the reconstruction.
+template <std::size_t R, FluxPolicy F, WenoWeights W = WenoJS>
+struct BasicFVWENO {
+    static constexpr bool rk3 = true;
+    using mesh_type = Mesh1d;
+
+    static constexpr size_t halo = R;
+    static constexpr bool stage_speed = false;  // op_L needs no global speed
+
+    size_t block(const Mesh1d &ex) const { return 1; }
+
+    // max |f'(u)| over cells [first, last)
+    double max_speed(const std::vector<double> &u, const Mesh1d &ex,
+                     size_t first, size_t last) const {
+        double df_max = 0;
+        for (size_t i = first; i < last; i++) {
+            double tmp = std::abs(F::df(u[i]));
+            if (tmp > df_max) df_max = tmp;
+        }
+        return df_max;
+    }
+
+    double dt(double df_max, const Mesh1d &ex) const {
+        return std::pow(ex.dx, static_cast<double>(2 * R - 1) / 3)
+               / (2 * df_max);
+    }
+
+    // L of the owned cells [first, last) of the padded slice u
+    void op_L(const std::vector<double> &u, double df_max, const Mesh1d &ex,
+              std::vector<double> &L, size_t first, size_t last) const {
+        size_t m = last - first;
+        auto &arena = scratch_arena();
+        auto frame = arena.frame();
+
+        // reconstruction of cells first - 1, ..., last
+        auto ul_p = arena.take(m + 2);
+        auto ur_m = arena.take(m + 2);
+        for (size_t k = 0; k < m + 2; k++) {
+            auto s = Stencil<R - 1, R - 1>(u, first + k + halo - 1);
+            weno_point<R, W>(s, ul_p[k], ur_m[k]);
+        }
+
+        // the flux at the left face of cell k gathers ur_m of cell k - 1
+        for (size_t k = 0; k < m; k++) {
+            auto r = Stencil<1, 0>(ur_m, k + 1);
+            auto l = Stencil<0, 1>(ul_p, k + 1);
+            double fhat_l = fhat_LF<F>(r[-1], l[0]);
+            double fhat_r = fhat_LF<F>(r[0], l[1]);
+            L[first + k] = (fhat_l - fhat_r) / ex.dx;
+        }
+    }
+
+    // numerical flux at the left face of owned cell i of the padded slice u,
+    // i in [0, n]
+    double face_flux(const std::vector<double> &u, double df_max,
+                     size_t i) const {
+        size_t c = i + halo;
+        double ul_l = 0;
+        double ur_l = 0;
+        double ul_c = 0;
+        double ur_c = 0;
+        weno_point<R, W>(Stencil<R - 1, R - 1>(u, c - 1), ul_l, ur_l);
+        weno_point<R, W>(Stencil<R - 1, R - 1>(u, c), ul_c, ur_c);
+        return fhat_LF<F>(ur_l, ul_c);
+    }
+
+    double get_dt(const Vec &var, Mesh1d &ex, double t) const {
+        return dt(max_speed(var.data, ex, 0, var.data.size()), ex);
+    }
+
+    Vec op_L(const Vec &var, Mesh1d &ex, double t) const {
+        size_t n = var.data.size();
+        auto &arena = scratch_arena<double>();
+        auto frame = arena.frame();
+        auto &u = arena.vector(n + 2 * halo);
+        pad_periodic(var.data, halo, 1, u);
+
+        auto L = std::vector<double>(n);
+        op_L(u, 0, ex, L, 0, n);
+        return Vec{std::move(L)};
+    }
+};
+
+using FVWENO7 = BasicFVWENO<4, Burgers>;
+using FVWENO9 = BasicFVWENO<5, Burgers>;
+}  // namespace flux::schemes
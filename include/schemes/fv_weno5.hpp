@@ -0,0 +1,123 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <utility>
+#include <vector>
+
+#include "numerical_flux.hpp"
+#include "period_index.hpp"
+#include "scratch_arena.hpp"
+#include "solver/preset.hpp"
+#include "stencil.hpp"
+#include "weno5.hpp"
+
+namespace flux::schemes {
+// FV-RK3-WENO5 for the scalar law F, framework independent.
+// The kernels work on a slice padded with `halo` ghost cells on each side
+// (see solver_threads.hpp); the periodic get_dt/op_L pad the whole state.
+//
+// The state holds State values, the WENO weights and the numerical fluxes
+// are computed in Real: <F, float> runs in single precision,
+// <F, double, float> in mixed precision (double state, float kernels).
+// W selects the nonlinear weights (WenoJS, WenoZ, WenoM).
+template <FluxPolicy F, std::floating_point State = double,
+          std::floating_point Real = State, WenoWeights W = WenoJS>
+struct BasicFVWENO5 {
+    static constexpr bool rk3 = true;
+    using mesh_type = Mesh1d;
+
+    static constexpr size_t halo = 3;
+    static constexpr bool stage_speed = false;  // op_L needs no global speed
+
+    size_t block(const Mesh1d &ex) const { return 1; }
+
+    // max |f'(u)| over cells [first, last)
+    double max_speed(const std::vector<State> &u, const Mesh1d &ex,
+                     size_t first, size_t last) const {
+        double df_max = 0;
+        for (size_t i = first; i < last; i++) {
+            double tmp = std::abs(F::df(u[i]));
+            if (tmp > df_max) df_max = tmp;
+        }
+        return df_max;
+    }
+
+    double dt(double df_max, const Mesh1d &ex) const {
+        return std::pow(ex.dx, 5.0 / 3) / (2 * df_max);
+    }
+
+    // cells per tile of op_L, the traces of a tile stay in L1
+    static constexpr size_t tile = 256;
+
+    // L of the owned cells [first, last) of the padded slice u, in one pass
+    // over tiles: the reconstruction, the fluxes and the update of a tile
+    // read the traces from the stack, so u is read and L written once
+    void op_L(const std::vector<State> &u, double df_max, const Mesh1d &ex,
+              std::vector<State> &L, size_t first, size_t last) const {
+        Real ul_p[tile + 2];
+        Real ur_m[tile + 2];
+        Real fhat[tile + 1];
+        for (size_t begin = first; begin < last; begin += tile) {
+            size_t m = std::min(tile, last - begin);
+
+            // reconstruction of cells begin - 1, ..., begin + m
+            for (size_t k = 0; k < m + 2; k++) {
+                auto s = Stencil<2, 2, State>(u, begin + k + halo - 1);
+                weno5_point<W>(real(s[-2]), real(s[-1]), real(s[0]),
+                               real(s[1]), real(s[2]), ul_p[k], ur_m[k]);
+            }
+
+            // fluxes at the faces begin - 1/2, ..., begin + m - 1/2, once each
+            for (size_t k = 0; k < m + 1; k++) {
+                fhat[k] = fhat_LF<F>(ur_m[k], ul_p[k + 1]);
+            }
+
+            for (size_t k = 0; k < m; k++) {
+                Real fhat_l = fhat[k];
+                Real fhat_r = fhat[k + 1];
+                L[begin + k] = static_cast<State>((fhat_l - fhat_r) / ex.dx);
+            }
+        }
+    }
+
+    // numerical flux at the left face of owned cell i of the padded slice u,
+    // i in [0, n]
+    double face_flux(const std::vector<State> &u, double df_max,
+                     size_t i) const {
+        auto s = Stencil<3, 2, State>(u, i + halo);
+        Real ul_l = 0;
+        Real ur_l = 0;
+        Real ul_c = 0;
+        Real ur_c = 0;
+        weno5_point<W>(real(s[-3]), real(s[-2]), real(s[-1]), real(s[0]),
+                       real(s[1]), ul_l, ur_l);
+        weno5_point<W>(real(s[-2]), real(s[-1]), real(s[0]), real(s[1]),
+                       real(s[2]), ul_c, ur_c);
+        return fhat_LF<F>(ur_l, ul_c);
+    }
+
+    double get_dt(const BasicVec<State> &var, Mesh1d &ex, double t) const {
+        return dt(max_speed(var.data, ex, 0, var.data.size()), ex);
+    }
+
+    BasicVec<State> op_L(const BasicVec<State> &var, Mesh1d &ex,
+                         double t) const {
+        size_t n = var.data.size();
+        auto &arena = scratch_arena<State>();
+        auto frame = arena.frame();
+        auto &u = arena.vector(n + 2 * halo);
+        pad_periodic(var.data, halo, 1, u);
+
+        auto L = std::vector<State>(n);
+        op_L(u, 0, ex, L, 0, n);
+        return BasicVec<State>{std::move(L)};
+    }
+
+private:
+    static Real real(State v) { return static_cast<Real>(v); }
+};
+
+using FVWENO5 = BasicFVWENO5<Burgers>;
+}  // namespace flux::schemes
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "solver/preset.hpp"
+
+namespace flux::schemes {
+// Dimension-by-dimension flux differences on a Mesh2d.
+//
+// A reconstruction `rec(s, c, ul, ur)` computes the left and right interface
+// values of one cell from the stencil s[0..2R], where s[k][c] is the value at
+// offset k - R along the sweep direction. The numerical flux `fhat(ul, ur)`
+// turns them into interface fluxes.
+//
+// The x-sweep handles one row at a time in a padded copy of the row, so the
+// stencil never wraps. The y-sweep walks down strips of `tile` columns: each
+// step reconstructs one row segment from 2R + 1 row segments, every cache
+// line of u is loaded once per strip, and the inner loops run over
+// contiguous memory. A naive y-sweep down each column touches a new cache
+// line for every cell and reloads it 2R + 1 times once nx is large.
+
+// L = (fhat_{i-1/2} - fhat_{i+1/2}) / dx for `rows` rows of nx cells,
+// periodic in x
+template <std::size_t R, typename Rec, typename Flux>
+void sweep_x(const double *u, double *L, std::size_t nx, std::size_t rows,
+             double dx, const Rec &rec, const Flux &fhat) {
+    const std::size_t g = R + 1;  // ghost cells, one more for the end faces
+
+    auto pad = std::vector<double>(nx + 2 * g);
+    auto ul = std::vector<double>(nx + 2);  // cells -1, ..., nx
+    auto ur = std::vector<double>(nx + 2);
+    auto fl = std::vector<double>(nx + 1);  // faces -1/2, ..., nx - 1/2
+
+    std::array<const double *, 2 * R + 1> s{};
+    for (std::size_t k = 0; k < s.size(); k++) s[k] = pad.data() + k;
+
+    for (std::size_t j = 0; j < rows; j++) {
+        const double *row = u + j * nx;
+        double *Lrow = L + j * nx;
+
+        std::copy(row, row + nx, pad.begin() + static_cast<std::ptrdiff_t>(g));
+        for (std::size_t k = 0; k < g; k++) {
+            pad[k] = row[(nx - g % nx + k) % nx];
+            pad[g + nx + k] = row[k % nx];
+        }
+
+        for (std::size_t c = 0; c < nx + 2; c++) rec(s, c, ul[c], ur[c]);
+        for (std::size_t i = 0; i <= nx; i++) fl[i] = fhat(ur[i], ul[i + 1]);
+        for (std::size_t i = 0; i < nx; i++) {
+            Lrow[i] = (fl[i] - fl[i + 1]) / dx;
+        }
+    }
+}
+
+// L += (fhat_{j-1/2} - fhat_{j+1/2}) / dy for the rows [first, last), where
+// L points at row 0 and `row(j)` returns row j of u for
+// j in [first - R - 1, last + R] (periodic wrap or ghost rows)
+template <std::size_t R, typename Row, typename Rec, typename Flux>
+void sweep_y(const Row &row, double *L, std::size_t nx, std::size_t first,
+             std::size_t last, double dy, std::size_t tile, const Rec &rec,
+             const Flux &fhat) {
+    if (first >= last) return;
+    tile = std::clamp<std::size_t>(tile, 1, nx);
+
+    auto ul_prev = std::vector<double>(tile);
+    auto ur_prev = std::vector<double>(tile);
+    auto ul_cur = std::vector<double>(tile);
+    auto ur_cur = std::vector<double>(tile);
+    auto g_prev = std::vector<double>(tile);
+    auto g_cur = std::vector<double>(tile);
+
+    std::array<const double *, 2 * R + 1> s{};
+
+    // reconstruct row j of the strip starting at column i0
+    auto rec_row = [&](std::size_t i0, std::size_t w, std::ptrdiff_t j,
+                       std::vector<double> &rl, std::vector<double> &rr) {
+        for (std::size_t k = 0; k < s.size(); k++) {
+            auto jj = j + static_cast<std::ptrdiff_t>(k)
+                      - static_cast<std::ptrdiff_t>(R);
+            s[k] = row(jj) + i0;
+        }
+        for (std::size_t i = 0; i < w; i++) rec(s, i, rl[i], rr[i]);
+    };
+
+    const auto jfirst = static_cast<std::ptrdiff_t>(first);
+    const auto jlast = static_cast<std::ptrdiff_t>(last);
+
+    for (std::size_t i0 = 0; i0 < nx; i0 += tile) {
+        const std::size_t w = std::min(tile, nx - i0);
+
+        rec_row(i0, w, jfirst - 1, ul_prev, ur_prev);
+        for (std::ptrdiff_t j = jfirst; j <= jlast; j++) {
+            rec_row(i0, w, j, ul_cur, ur_cur);
+
+            // face j - 1/2
+            for (std::size_t i = 0; i < w; i++) {
+                g_cur[i] = fhat(ur_prev[i], ul_cur[i]);
+            }
+
+            if (j > jfirst) {
+                double *Lrow = L + static_cast<std::size_t>(j - 1) * nx + i0;
+                for (std::size_t i = 0; i < w; i++) {
+                    Lrow[i] += (g_prev[i] - g_cur[i]) / dy;
+                }
+            }
+
+            std::swap(g_prev, g_cur);
+            std::swap(ul_prev, ul_cur);
+            std::swap(ur_prev, ur_cur);
+        }
+    }
+}
+
+// row accessor of a periodic nx * ny array
+inline auto periodic_rows(const std::vector<double> &u, const Mesh2d &ex) {
+    return [&u, nx = ex.nx, ny = static_cast<std::ptrdiff_t>(ex.ny)](
+               std::ptrdiff_t j) {
+        auto jj = static_cast<std::size_t>((j % ny + ny) % ny);
+        return u.data() + jj * nx;
+    };
+}
+
+// row accessor of an array padded with `halo` ghost rows on each side
+inline auto padded_rows(const std::vector<double> &u, const Mesh2d &ex,
+                        std::size_t halo) {
+    return [&u, nx = ex.nx, g = static_cast<std::ptrdiff_t>(halo)](
+               std::ptrdiff_t j) {
+        return u.data() + static_cast<std::size_t>(j + g) * nx;
+    };
+}
+}  // namespace flux::schemes
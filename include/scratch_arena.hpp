@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <new>
+#include <span>
+#include <vector>
+
+namespace flux {
+// Reusable scratch buffers for the temporaries of the kernels (traces,
+// fluxes, padded copies).
+//
+// A kernel opens a Frame, takes the buffers it needs and hands them back
+// when the frame ends, so every op_L call or stage starts from the same
+// buffers. A buffer is only allocated when a call needs more than the
+// previous ones did: after the first step the kernels allocate nothing, and
+// the pages are faulted in once. Each thread has its own arena
+// (scratch_arena), which it first touches itself.
+template <typename T>
+class ScratchArena {
+public:
+    static constexpr std::size_t alignment = 64;
+
+    class Frame {
+    public:
+        explicit Frame(ScratchArena &arena)
+            : m_arena(arena), m_buffers(arena.m_next_buffer),
+              m_vectors(arena.m_next_vector) {}
+
+        Frame(const Frame &) = delete;
+
+        Frame &operator=(const Frame &) = delete;
+
+        ~Frame() {
+            m_arena.m_next_buffer = m_buffers;
+            m_arena.m_next_vector = m_vectors;
+        }
+
+    private:
+        ScratchArena &m_arena;
+        std::size_t m_buffers;
+        std::size_t m_vectors;
+    };
+
+    [[nodiscard]] Frame frame() { return Frame(*this); }
+
+    // n uninitialized values, aligned to `alignment` bytes
+    std::span<T> take(std::size_t n) {
+        if (m_next_buffer == m_buffers.size()) m_buffers.emplace_back();
+        auto &b = m_buffers[m_next_buffer++];
+        if (b.capacity < n) {
+            std::size_t bytes = (n * sizeof(T) + alignment - 1) / alignment
+                                * alignment;
+            b.data.reset(
+                static_cast<T *>(std::aligned_alloc(alignment, bytes)));
+            if (!b.data) throw std::bad_alloc{};
+            b.capacity = bytes / sizeof(T);
+        }
+        return {b.data.get(), n};
+    }
+
+    // a std::vector of n values for the interfaces that take one (the padded
+    // state of the periodic op_L), with unspecified values
+    std::vector<T> &vector(std::size_t n) {
+        if (m_next_vector == m_vectors.size()) m_vectors.emplace_back();
+        auto &v = m_vectors[m_next_vector++];
+        v.resize(n);
+        return v;
+    }
+
+private:
+    struct Free {
+        void operator()(T *p) const { std::free(p); }
+    };
+
+    struct Buffer {
+        std::unique_ptr<T[], Free> data;
+        std::size_t capacity{0};
+    };
+
+    std::vector<Buffer> m_buffers;
+    std::deque<std::vector<T>> m_vectors;  // references stay valid
+    std::size_t m_next_buffer{0};
+    std::size_t m_next_vector{0};
+};
+
+// the arena of the calling thread
+template <typename T = double>
+ScratchArena<T> &scratch_arena() {
+    thread_local ScratchArena<T> arena;
+    return arena;
+}
+}  // namespace flux
@@ -0,0 +1,298 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "expected.hpp"
+#include "profiler.hpp"
+
+namespace flux {
+
+// Checkpoint file layout (native byte order, 48-byte header):
+//   char[8]  magic "FLUXCKPT"
+//   uint32   version
+//   uint32   byte order tag 0x01020304
+//   double   t
+//   uint64   iter
+//   uint64   count
+//   uint64   tag, 0 unless the writer sets it (the result cache stores a
+//            hash of its key there)
+//   double   payload[count]
+//   uint64   FNV-1a checksum of all preceding bytes
+//
+// Files are written to "<path>.tmp" and renamed, so a crash during a write
+// never destroys the previous checkpoint.
+
+struct CheckpointConfig {
+    std::string path;
+    std::size_t interval{0};  // iterations between checkpoints, 0 disables
+};
+
+template <typename VarType>
+struct Checkpoint {
+    VarType var;
+    double t;
+    std::size_t iter;
+    std::uint64_t tag{0};
+};
+
+// Conversion between a state and its payload. The default handles types with
+// a `std::vector<T> data` member (e.g. Vec, BasicVec<float>), the payload is
+// always stored as double; specialize it for others.
+template <typename VarType>
+struct CheckpointIO {
+    using value_type = typename decltype(VarType::data)::value_type;
+
+    static std::vector<double> save(const VarType &var) {
+        return {var.data.begin(), var.data.end()};
+    }
+
+    static VarType load(std::vector<double> data) {
+        if constexpr (std::is_same_v<value_type, double>) {
+            return VarType{std::move(data)};
+        }
+        else {
+            return VarType{std::vector<value_type>(data.begin(), data.end())};
+        }
+    }
+};
+
+namespace detail {
+
+inline constexpr char checkpoint_magic[8] = {'F', 'L', 'U', 'X',
+                                             'C', 'K', 'P', 'T'};
+inline constexpr std::uint32_t checkpoint_version = 1;
+inline constexpr std::uint32_t checkpoint_byte_order = 0x01020304;
+inline constexpr std::size_t checkpoint_header_size = 48;
+
+inline constexpr std::uint64_t fnv1a_basis = 14695981039346656037ULL;
+
+// `hash` continues a previous hash, or seeds an independent one
+inline std::uint64_t fnv1a(const char *bytes, std::size_t len,
+                           std::uint64_t hash = fnv1a_basis) {
+    for (std::size_t i = 0; i < len; ++i) {
+        hash ^= static_cast<unsigned char>(bytes[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+template <typename T>
+void put(std::vector<char> &buf, std::size_t &pos, const T &value) {
+    std::memcpy(buf.data() + pos, &value, sizeof(T));
+    pos += sizeof(T);
+}
+
+template <typename T>
+T get(const std::vector<char> &buf, std::size_t &pos) {
+    T value;
+    std::memcpy(&value, buf.data() + pos, sizeof(T));
+    pos += sizeof(T);
+    return value;
+}
+
+// returns an empty string on success, otherwise the error message
+inline std::string write_checkpoint_file(const std::string &path, double t,
+                                         std::size_t iter,
+                                         const std::vector<double> &payload,
+                                         std::uint64_t tag = 0) {
+    const std::size_t payload_size = payload.size() * sizeof(double);
+    std::vector<char> buf(checkpoint_header_size + payload_size
+                          + sizeof(std::uint64_t));
+
+    std::size_t pos = 0;
+    std::memcpy(buf.data(), checkpoint_magic, sizeof(checkpoint_magic));
+    pos += sizeof(checkpoint_magic);
+    put(buf, pos, checkpoint_version);
+    put(buf, pos, checkpoint_byte_order);
+    put(buf, pos, t);
+    put(buf, pos, static_cast<std::uint64_t>(iter));
+    put(buf, pos, static_cast<std::uint64_t>(payload.size()));
+    put(buf, pos, tag);
+    if (payload_size > 0) {
+        std::memcpy(buf.data() + pos, payload.data(), payload_size);
+        pos += payload_size;
+    }
+    put(buf, pos, fnv1a(buf.data(), pos));
+
+    const std::string tmp_path = path + ".tmp";
+    {
+        std::ofstream f(tmp_path, std::ios::binary | std::ios::trunc);
+        if (f.fail()) { return "checkpoint: fail to open file " + tmp_path; }
+        f.write(buf.data(), static_cast<std::streamsize>(buf.size()));
+        if (f.fail()) { return "checkpoint: fail to write file " + tmp_path; }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmp_path, path, ec);
+    if (ec) { return "checkpoint: fail to rename " + tmp_path + ": " + ec.message(); }
+
+    return {};
+}
+
+}  // namespace detail
+
+template <typename VarType>
+auto save_checkpoint(const std::string &path, const VarType &var, double t,
+                     std::size_t iter, std::uint64_t tag = 0)
+    -> flux::expected<bool, std::string> {
+    auto err = detail::write_checkpoint_file(
+        path, t, iter, CheckpointIO<VarType>::save(var), tag);
+    if (!err.empty()) { return flux::unexpected{err}; }
+    return true;
+}
+
+template <typename VarType>
+auto load_checkpoint(const std::string &path)
+    -> flux::expected<Checkpoint<VarType>, std::string> {
+    using detail::checkpoint_header_size;
+
+    std::ifstream f(path, std::ios::binary | std::ios::ate);
+    if (f.fail()) {
+        return flux::unexpected{"checkpoint: fail to open file " + path};
+    }
+    auto file_size = static_cast<std::size_t>(f.tellg());
+    if (file_size < checkpoint_header_size + sizeof(std::uint64_t)) {
+        return flux::unexpected{"checkpoint: truncated file " + path};
+    }
+
+    std::vector<char> buf(file_size);
+    f.seekg(0);
+    f.read(buf.data(), static_cast<std::streamsize>(file_size));
+    if (f.fail()) {
+        return flux::unexpected{"checkpoint: fail to read file " + path};
+    }
+
+    if (std::memcmp(buf.data(), detail::checkpoint_magic,
+                    sizeof(detail::checkpoint_magic))
+        != 0) {
+        return flux::unexpected{"checkpoint: bad magic in " + path};
+    }
+
+    std::size_t pos = sizeof(detail::checkpoint_magic);
+    auto version = detail::get<std::uint32_t>(buf, pos);
+    auto byte_order = detail::get<std::uint32_t>(buf, pos);
+    if (version != detail::checkpoint_version) {
+        return flux::unexpected{"checkpoint: unsupported version "
+                                + std::to_string(version)};
+    }
+    if (byte_order != detail::checkpoint_byte_order) {
+        return flux::unexpected{std::string{"checkpoint: byte order mismatch"}};
+    }
+
+    auto t = detail::get<double>(buf, pos);
+    auto iter = detail::get<std::uint64_t>(buf, pos);
+    auto count = detail::get<std::uint64_t>(buf, pos);
+    auto tag = detail::get<std::uint64_t>(buf, pos);
+
+    const auto payload_size =
+        file_size - checkpoint_header_size - sizeof(std::uint64_t);
+    if (payload_size % sizeof(double) != 0
+        || count != payload_size / sizeof(double)) {
+        return flux::unexpected{"checkpoint: size mismatch in " + path};
+    }
+
+    std::size_t checksum_pos = file_size - sizeof(std::uint64_t);
+    auto checksum = detail::get<std::uint64_t>(buf, checksum_pos);
+    if (checksum != detail::fnv1a(buf.data(), file_size - sizeof(std::uint64_t))) {
+        return flux::unexpected{"checkpoint: checksum mismatch in " + path};
+    }
+
+    std::vector<double> payload(count);
+    if (count > 0) {
+        std::memcpy(payload.data(), buf.data() + pos, count * sizeof(double));
+    }
+
+    return Checkpoint<VarType>{CheckpointIO<VarType>::load(std::move(payload)),
+                               t, static_cast<std::size_t>(iter), tag};
+}
+
+// Writes checkpoints on a background thread. The state is copied on the
+// calling thread, encoding and file I/O overlap with the next iterations.
+// At most one write is in flight.
+class CheckpointWriter {
+public:
+    explicit CheckpointWriter(std::string path) : m_path(std::move(path)) {}
+
+    CheckpointWriter(const CheckpointWriter &) = delete;
+
+    CheckpointWriter &operator=(const CheckpointWriter &) = delete;
+
+    ~CheckpointWriter() { wait(); }
+
+    // returns false if the previous write failed
+    bool submit(std::vector<double> payload, double t, std::size_t iter) {
+        if (!wait()) return false;
+
+        m_pending = std::async(
+            std::launch::async,
+            [path = m_path, payload = std::move(payload), t, iter]() {
+                return detail::write_checkpoint_file(path, t, iter, payload);
+            });
+        return true;
+    }
+
+    // returns false if the last write failed
+    bool wait() {
+        if (m_pending.valid()) {
+            auto err = m_pending.get();
+            if (!err.empty()) m_error = std::move(err);
+        }
+        return m_error.empty();
+    }
+
+    const std::string &error() const { return m_error; }
+
+private:
+    std::string m_path;
+    std::future<std::string> m_pending;
+    std::string m_error;
+};
+
+// Shared time loop of the run/run_from_checkpoint entry points.
+// `update(var, t, stop_flag)` advances one iteration and returns the new
+// state, or a flux::expected of it when the update can fail.
+template <typename VarType, typename UpdateFunc>
+auto run_with_checkpoint(VarType var, double t, std::size_t iter, double tend,
+                         const CheckpointConfig &cfg, UpdateFunc &&update)
+    -> flux::expected<VarType, std::string> {
+    FLUX_PROFILE_RUN();
+
+    if (tend <= t) return var;
+
+    CheckpointWriter writer(cfg.path);
+    const bool enabled = cfg.interval > 0 && !cfg.path.empty();
+
+    bool stop_flag = false;
+    constexpr auto iter_max = std::numeric_limits<std::size_t>::max();
+    for (; iter < iter_max && (!stop_flag); ++iter) {
+        auto next = update(var, t, stop_flag);
+        if constexpr (std::is_same_v<decltype(next), VarType>) {
+            var = std::move(next);
+        }
+        else {
+            if (!next) { return flux::unexpected{std::move(next.error())}; }
+            var = std::move(next.value());
+        }
+
+        if (enabled && !stop_flag && (iter + 1) % cfg.interval == 0) {
+            if (!writer.submit(CheckpointIO<VarType>::save(var), t, iter + 1)) {
+                return flux::unexpected{writer.error()};
+            }
+        }
+    }
+    if (!writer.wait()) { return flux::unexpected{writer.error()}; }
+    if (!stop_flag) { return flux::unexpected{std::string{"Iteration exceeds"}}; }
+
+    return var;
+}
+
+}  // namespace flux
@@ -0,0 +1,299 @@
+#pragma once
+
+// Jacobian-free Newton-Krylov building blocks of the implicit integrators
+// (solver_implicit.hpp). Everything works on the flat state vector and only
+// needs the spatial operator L(u), so any scheme's op_L can be reused:
+//
+//   jacobian_vector  J v ~ (L(u + h v) - L(u)) / h
+//   BlockJacobi      inverse of the diagonal blocks of I - alpha J, built
+//                    from a few colored evaluations of L
+//   gmres            restarted GMRES, right preconditioned
+//   newton           solves U - alpha L(U) = rhs
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace flux::implicit {
+
+using Vector = std::vector<double>;
+
+inline double dot(const Vector &a, const Vector &b) {
+    double s = 0;
+    for (size_t i = 0; i < a.size(); i++) s += a[i] * b[i];
+    return s;
+}
+
+inline double norm(const Vector &a) { return std::sqrt(dot(a, a)); }
+
+// root mean square, independent of the number of cells
+inline double rms(const Vector &a) {
+    return a.empty() ? 0 : norm(a) / std::sqrt(static_cast<double>(a.size()));
+}
+
+// y += s x
+inline void axpy(double s, const Vector &x, Vector &y) {
+    for (size_t i = 0; i < y.size(); i++) y[i] += s * x[i];
+}
+
+struct NewtonKrylovConfig {
+    double newton_tol = 1e-10;  // rms of the nonlinear residual
+    size_t newton_max = 20;
+
+    double krylov_rtol = 1e-4;  // relative residual of each linear solve
+    size_t krylov_restart = 30;
+    size_t krylov_max = 300;
+
+    // values per block of the preconditioner (DG_k + 1 for DG, 0 disables
+    // it) and how many blocks on each side a block of L depends on
+    size_t block = 0;
+    size_t coupling = 1;
+};
+
+struct KrylovResult {
+    bool converged;
+    size_t iterations;
+};
+
+// J v at u with L(u) = Lu, one evaluation of L
+template <typename Op>
+Vector jacobian_vector(Op &&L, const Vector &u, const Vector &Lu,
+                       const Vector &v) {
+    double nv = norm(v);
+    if (nv == 0) return Vector(u.size());
+
+    // h balances truncation and rounding error
+    double h = std::sqrt(std::numeric_limits<double>::epsilon())
+               * (1 + norm(u)) / nv;
+    auto up = u;
+    axpy(h, v, up);
+    auto result = L(up);
+    for (size_t i = 0; i < result.size(); i++) {
+        result[i] = (result[i] - Lu[i]) / h;
+    }
+    return result;
+}
+
+// M^{-1} for the diagonal blocks M_b of I - alpha J, with J = dL/du at u.
+// A block depends on `coupling` blocks on each side (1 for DG), so
+// perturbing every (2 coupling + 1)-th block at once yields all diagonal
+// blocks from (2 coupling + 1) (block + 1) evaluations of L. The blocks are
+// LU factorized with partial pivoting.
+class BlockJacobi {
+public:
+    BlockJacobi() = default;  // identity
+
+    template <typename Op>
+    BlockJacobi(Op &&L, const Vector &u, const Vector &Lu, double alpha,
+                size_t block, size_t coupling)
+        : m_block(block), m_lu(u.size() * block), m_pivot(u.size()) {
+        const size_t nb = u.size() / block;
+        const size_t stride = 2 * coupling + 1;
+
+        // the last nb % stride blocks get a color each, so that colors do not
+        // meet across the periodic boundary
+        const size_t regular = nb - nb % stride;
+        const size_t colors = stride + nb % stride;
+        auto color = [&](size_t b) {
+            return b < regular ? b % stride : stride + (b - regular);
+        };
+
+        double h = std::sqrt(std::numeric_limits<double>::epsilon())
+                   * (1 + rms(u));
+        for (size_t c = 0; c < colors; c++) {
+            for (size_t j = 0; j < block; j++) {
+                auto up = u;
+                for (size_t b = 0; b < nb; b++) {
+                    if (color(b) == c) up[b * block + j] += h;
+                }
+                auto Lp = L(up);
+                for (size_t b = 0; b < nb; b++) {
+                    if (color(b) != c) continue;
+                    for (size_t i = 0; i < block; i++) {
+                        size_t r = b * block + i;
+                        double dL = (Lp[r] - Lu[r]) / h;
+                        entry(b, i, j) = (i == j ? 1 : 0) - alpha * dL;
+                    }
+                }
+            }
+        }
+        for (size_t b = 0; b < nb; b++) factorize(b);
+    }
+
+    // z = M^{-1} r
+    void apply(const Vector &r, Vector &z) const {
+        z = r;
+        if (m_block == 0) return;
+
+        const size_t nb = r.size() / m_block;
+        for (size_t b = 0; b < nb; b++) {
+            double *x = z.data() + b * m_block;
+            const size_t *piv = m_pivot.data() + b * m_block;
+            for (size_t i = 0; i < m_block; i++) std::swap(x[i], x[piv[i]]);
+            for (size_t i = 0; i < m_block; i++) {
+                for (size_t j = 0; j < i; j++) x[i] -= entry(b, i, j) * x[j];
+            }
+            for (size_t i = m_block; i-- > 0;) {
+                for (size_t j = i + 1; j < m_block; j++) {
+                    x[i] -= entry(b, i, j) * x[j];
+                }
+                x[i] /= entry(b, i, i);
+            }
+        }
+    }
+
+private:
+    double &entry(size_t b, size_t i, size_t j) {
+        return m_lu[(b * m_block + i) * m_block + j];
+    }
+
+    double entry(size_t b, size_t i, size_t j) const {
+        return m_lu[(b * m_block + i) * m_block + j];
+    }
+
+    // in place, pivot[i] is the row swapped with row i at step i
+    void factorize(size_t b) {
+        size_t *piv = m_pivot.data() + b * m_block;
+        for (size_t k = 0; k < m_block; k++) {
+            size_t p = k;
+            for (size_t i = k + 1; i < m_block; i++) {
+                if (std::abs(entry(b, i, k)) > std::abs(entry(b, p, k))) p = i;
+            }
+            piv[k] = p;
+            for (size_t j = 0; j < m_block; j++) {
+                std::swap(entry(b, k, j), entry(b, p, j));
+            }
+            for (size_t i = k + 1; i < m_block; i++) {
+                entry(b, i, k) /= entry(b, k, k);
+                for (size_t j = k + 1; j < m_block; j++) {
+                    entry(b, i, j) -= entry(b, i, k) * entry(b, k, j);
+                }
+            }
+        }
+    }
+
+    size_t m_block{0};
+    std::vector<double> m_lu;
+    std::vector<size_t> m_pivot;
+};
+
+// Solves A x = b from the initial guess x by restarted GMRES(m) with right
+// preconditioning, A M^{-1} y = b, x = M^{-1} y, so the residual it
+// monitors is the true one.
+template <typename MatVec>
+KrylovResult gmres(MatVec &&A, const BlockJacobi &M, const Vector &b,
+                   Vector &x, const NewtonKrylovConfig &cfg) {
+    const size_t m = cfg.krylov_restart;
+    const double target = cfg.krylov_rtol * norm(b);
+
+    std::vector<Vector> V(m + 1);
+    std::vector<Vector> Z(m);
+    auto H = std::vector<double>((m + 1) * m);
+    auto cs = std::vector<double>(m);
+    auto sn = std::vector<double>(m);
+    auto g = std::vector<double>(m + 1);
+    auto h = [&](size_t i, size_t j) -> double & { return H[i * m + j]; };
+
+    size_t iterations = 0;
+    while (true) {
+        auto r = A(x);
+        for (size_t i = 0; i < r.size(); i++) r[i] = b[i] - r[i];
+        double beta = norm(r);
+        if (beta <= target) return {true, iterations};
+        if (iterations >= cfg.krylov_max) return {false, iterations};
+
+        V[0] = r;
+        for (auto &v : V[0]) v /= beta;
+        std::fill(g.begin(), g.end(), 0);
+        g[0] = beta;
+
+        size_t k = 0;
+        for (; k < m && iterations < cfg.krylov_max; k++, iterations++) {
+            M.apply(V[k], Z[k]);
+            V[k + 1] = A(Z[k]);
+
+            // modified Gram-Schmidt
+            for (size_t i = 0; i <= k; i++) {
+                h(i, k) = dot(V[k + 1], V[i]);
+                axpy(-h(i, k), V[i], V[k + 1]);
+            }
+            h(k + 1, k) = norm(V[k + 1]);
+            if (h(k + 1, k) > 0) {
+                for (auto &v : V[k + 1]) v /= h(k + 1, k);
+            }
+
+            // Givens rotations keep H upper triangular
+            for (size_t i = 0; i < k; i++) {
+                double tmp = cs[i] * h(i, k) + sn[i] * h(i + 1, k);
+                h(i + 1, k) = -sn[i] * h(i, k) + cs[i] * h(i + 1, k);
+                h(i, k) = tmp;
+            }
+            double d = std::hypot(h(k, k), h(k + 1, k));
+            cs[k] = h(k, k) / d;
+            sn[k] = h(k + 1, k) / d;
+            h(k, k) = d;
+            h(k + 1, k) = 0;
+            g[k + 1] = -sn[k] * g[k];
+            g[k] = cs[k] * g[k];
+
+            if (std::abs(g[k + 1]) <= target) {
+                k++;
+                iterations++;
+                break;
+            }
+        }
+
+        // x += Z y with H y = g
+        auto y = std::vector<double>(k);
+        for (size_t i = k; i-- > 0;) {
+            y[i] = g[i];
+            for (size_t j = i + 1; j < k; j++) y[i] -= h(i, j) * y[j];
+            y[i] /= h(i, i);
+        }
+        for (size_t i = 0; i < k; i++) axpy(y[i], Z[i], x);
+    }
+}
+
+struct NewtonResult {
+    bool converged;
+    size_t iterations;
+    size_t krylov_iterations;
+};
+
+// Solves G(U) = U - alpha L(U) - rhs = 0 for U from the initial guess U by
+// inexact Newton; the Jacobian I - alpha J is only applied through
+// jacobian_vector, M approximates it.
+template <typename Op>
+NewtonResult newton(Op &&L, double alpha, const Vector &rhs, Vector &U,
+                    const BlockJacobi &M, const NewtonKrylovConfig &cfg) {
+    NewtonResult result{false, 0, 0};
+    auto LU = L(U);
+    for (; result.iterations <= cfg.newton_max; result.iterations++) {
+        auto G = Vector(U.size());
+        for (size_t i = 0; i < U.size(); i++) {
+            G[i] = rhs[i] + alpha * LU[i] - U[i];  // -G(U)
+        }
+        if (rms(G) <= cfg.newton_tol) {
+            result.converged = true;
+            return result;
+        }
+        if (result.iterations == cfg.newton_max) break;
+
+        auto A = [&](const Vector &v) {
+            auto Jv = jacobian_vector(L, U, LU, v);
+            for (size_t i = 0; i < v.size(); i++) Jv[i] = v[i] - alpha * Jv[i];
+            return Jv;
+        };
+        auto delta = Vector(U.size());
+        auto lin = gmres(A, M, G, delta, cfg);
+        result.krylov_iterations += lin.iterations;
+
+        axpy(1, delta, U);
+        LU = L(U);
+    }
+    return result;
+}
+
+}  // namespace flux::implicit
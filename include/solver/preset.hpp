@@ -1,5 +1,7 @@
 #pragma once
 
+#include <concepts>
+#include <tuple>
 #include <vector>
 
 #include "requires.h"
@@ -8,45 +10,65 @@ namespace flux {
 
 struct Mesh1d {
     double dx;
+
+    auto cache_key() const { return std::tuple{dx}; }
 };
 
-struct Vec {
-    std::vector<double> data;
+// uniform periodic 2d mesh, cell (i, j) is stored at j * nx + i (row-major)
+struct Mesh2d {
+    double dx;
+    double dy;
+    size_t nx;
+    size_t ny;
+
+    auto cache_key() const { return std::tuple{dx, dy, nx, ny}; }
+};
 
-    explicit Vec(std::vector<double> d) : data(std::move(d)) {}
+// state of scalar type T, Vec is the double instance
+template <std::floating_point T>
+struct BasicVec {
+    using value_type = T;
 
-    Vec(const Vec &rhs) = default;
+    std::vector<T> data;
 
-    Vec &operator=(const Vec &rhs) = default;
+    explicit BasicVec(std::vector<T> d) : data(std::move(d)) {}
 
-    Vec(Vec &&rhs) noexcept = default;
+    BasicVec(const BasicVec &rhs) = default;
 
-    Vec &operator=(Vec &&rhs) noexcept = default;
+    BasicVec &operator=(const BasicVec &rhs) = default;
 
-    ~Vec() = default;
+    BasicVec(BasicVec &&rhs) noexcept = default;
 
-    Vec operator+(const Vec &rhs) const {
-        Vec result(data);
+    BasicVec &operator=(BasicVec &&rhs) noexcept = default;
+
+    ~BasicVec() = default;
+
+    BasicVec operator+(const BasicVec &rhs) const {
+        BasicVec result(data);
         for (size_t i = 0; i < data.size(); ++i) {
             result.data[i] += rhs.data[i];
         }
         return result;
     }
 
-    Vec operator-(const Vec &rhs) const {
-        Vec result(data);
+    BasicVec operator-(const BasicVec &rhs) const {
+        BasicVec result(data);
         for (size_t i = 0; i < data.size(); ++i) {
             result.data[i] -= rhs.data[i];
         }
         return result;
     }
 
-    friend Vec operator*(double scalar, const Vec &vec) {
-        Vec result(vec);
-        for (auto &v : result.data) { v *= scalar; }
+    friend BasicVec operator*(double scalar, const BasicVec &vec) {
+        BasicVec result(vec);
+        for (auto &v : result.data) { v = static_cast<T>(scalar * v); }
         return result;
     }
 };
 
+using Vec = BasicVec<double>;
+
 static_assert(VarRequirements<Vec>, "Vec does not satisfy VarRequirements!");
+static_assert(VarRequirements<BasicVec<float>>,
+              "BasicVec<float> does not satisfy VarRequirements!");
 }  // namespace flux
@@ -0,0 +1,158 @@
+#pragma once
+
+// Opt-in per-phase instrumentation of the time integrators.
+//
+// Define FLUX_PROFILE (CMake option FLUX_PROFILE=ON) to collect, for every
+// phase of `update`, the call count, total/min/max wall time and the
+// compulsory bytes touched (operands read once, result written once).
+// A summary is printed to std::clog when the outermost `run` returns.
+//
+// Without FLUX_PROFILE, FLUX_PROFILE_CALL(phase, bytes, expr) expands to
+// `(expr)` and FLUX_PROFILE_RUN() to nothing, so the byte counts are never
+// evaluated and the generated code is unchanged.
+
+#ifdef FLUX_PROFILE
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+
+namespace flux::profile {
+
+enum class Phase : std::size_t {
+    get_dt = 0,
+    op_L,
+    pre_process,
+    post_process,
+    post_process_rk_stage,
+    rk_combine,
+    count
+};
+
+inline const char *phase_name(std::size_t i) {
+    constexpr const char *names[] = {
+        "get_dt",       "op_L",
+        "pre_process",  "post_process",
+        "post_process_rk_stage", "rk_combine",
+    };
+    return names[i];
+}
+
+struct PhaseStats {
+    std::size_t calls{0};
+    double total{0};
+    double min{std::numeric_limits<double>::max()};
+    double max{0};
+    std::size_t bytes{0};
+};
+
+class Profiler {
+public:
+    static Profiler &instance() {
+        thread_local Profiler profiler;
+        return profiler;
+    }
+
+    void record(Phase phase, double seconds, std::size_t bytes) {
+        auto &s = m_stats[static_cast<std::size_t>(phase)];
+        s.calls++;
+        s.total += seconds;
+        if (seconds < s.min) s.min = seconds;
+        if (seconds > s.max) s.max = seconds;
+        s.bytes += bytes;
+    }
+
+    void report(std::ostream &out) const {
+        double total = 0;
+        for (const auto &s : m_stats) total += s.total;
+        if (total <= 0) return;
+
+        out << "flux profile:\n"
+            << std::setw(22) << "phase" << std::setw(10) << "calls"
+            << std::setw(12) << "total[s]" << std::setw(8) << "share"
+            << std::setw(12) << "min[us]" << std::setw(12) << "max[us]"
+            << std::setw(12) << "MB" << std::setw(10) << "GB/s" << '\n';
+
+        auto flags = out.flags();
+        for (std::size_t i = 0; i < m_stats.size(); ++i) {
+            const auto &s = m_stats[i];
+            if (s.calls == 0) continue;
+
+            auto mb = static_cast<double>(s.bytes) / 1e6;
+            out << std::setw(22) << phase_name(i) << std::setw(10) << s.calls
+                << std::fixed << std::setprecision(4) << std::setw(12)
+                << s.total << std::setprecision(1) << std::setw(7)
+                << 100 * s.total / total << '%' << std::setprecision(2)
+                << std::setw(12) << s.min * 1e6 << std::setw(12)
+                << s.max * 1e6 << std::setprecision(1) << std::setw(12) << mb
+                << std::setprecision(2) << std::setw(10)
+                << (s.total > 0 ? mb / 1e3 / s.total : 0.0) << '\n';
+            out.flags(flags);
+        }
+        out << std::flush;
+    }
+
+    void reset() { m_stats = {}; }
+
+    std::size_t depth{0};  // nesting of run(), only the outermost reports
+
+private:
+    std::array<PhaseStats, static_cast<std::size_t>(Phase::count)> m_stats{};
+};
+
+template <typename VarType>
+std::size_t bytes_of(const VarType &var) {
+    if constexpr (requires { var.data.size(); }) {
+        return var.data.size() * sizeof(var.data[0]);
+    }
+    else {
+        return sizeof(VarType);
+    }
+}
+
+template <typename Func>
+auto timed(Phase phase, std::size_t bytes, Func &&func) {
+    auto start = std::chrono::steady_clock::now();
+    auto result = func();
+    auto stop = std::chrono::steady_clock::now();
+
+    Profiler::instance().record(
+        phase, std::chrono::duration<double>(stop - start).count(), bytes);
+    return result;
+}
+
+class RunReport {
+public:
+    RunReport() { Profiler::instance().depth++; }
+
+    RunReport(const RunReport &) = delete;
+
+    RunReport &operator=(const RunReport &) = delete;
+
+    ~RunReport() {
+        auto &profiler = Profiler::instance();
+        if (--profiler.depth == 0) {
+            profiler.report(std::clog);
+            profiler.reset();
+        }
+    }
+};
+
+}  // namespace flux::profile
+
+#define FLUX_PROFILE_CALL(phase, bytes, ...)                                  \
+    ::flux::profile::timed(::flux::profile::Phase::phase, (bytes),            \
+                           [&] { return __VA_ARGS__; })
+
+#define FLUX_PROFILE_RUN() ::flux::profile::RunReport flux_profile_run_report_
+
+#else
+
+#define FLUX_PROFILE_CALL(phase, bytes, ...) (__VA_ARGS__)
+
+#define FLUX_PROFILE_RUN() static_cast<void>(0)
+
+#endif
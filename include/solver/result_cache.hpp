@@ -0,0 +1,153 @@
+#pragma once
+
+// Content-addressed cache of solver runs for the order and plot tests.
+//
+// The key is an FNV-1a hash of
+//   - result_cache_version, which stands for the numerics of the schemes and
+//     solvers: bump it when a change alters their results,
+//   - the types and cache_key() of the solver and its scheme,
+//   - the initial state, which stands for init, n, the domain and the
+//     quadrature of the Config,
+//   - the type and cache_key() of the mesh, t0 and tend.
+// cache_key() returns a tuple of the parameters of a solver or mesh, either
+// arithmetic values or objects with a cache_key() of their own; empty types
+// need none. An entry is a checkpoint (see checkpoint.hpp) of the final state
+// in ".cache/<key>.ckpt" next to the output file of the test, its tag is a
+// second hash of the key; a hit returns it bitwise, so the error norms and
+// the exported data computed from it are those of a fresh solve. Rebuilds
+// keep the entries, so changes to the plotting or export code reuse them.
+//
+// Solvers with state but no cache_key() (std::function, thread teams) are
+// not cached, others opt out with `static constexpr bool cache_results =
+// false;`. The cache is disabled by FLUX_CACHE=0 and in profiled builds.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include "checkpoint.hpp"
+#include "expected.hpp"
+
+namespace flux {
+
+namespace detail {
+
+// bump when the results of a scheme or solver change
+inline constexpr std::uint32_t result_cache_version = 3;
+
+template <typename T>
+concept CacheKeyed =
+    std::is_empty_v<T> || requires(const T &value) { value.cache_key(); };
+
+template <typename SolverType, typename ExType>
+constexpr bool cacheable() {
+    if constexpr (requires { SolverType::cache_results; }) {
+        if constexpr (!SolverType::cache_results) return false;
+    }
+    return CacheKeyed<SolverType> && CacheKeyed<ExType>;
+}
+
+inline bool result_cache_enabled() {
+#ifdef FLUX_PROFILE
+    return false;
+#else
+    const char *env = std::getenv("FLUX_CACHE");
+    return env == nullptr || std::strcmp(env, "0") != 0;
+#endif
+}
+
+template <typename T>
+void append_bytes(std::vector<char> &key, const T &value) {
+    const auto *p = reinterpret_cast<const char *>(&value);
+    key.insert(key.end(), p, p + sizeof(T));
+}
+
+inline void append_bytes(std::vector<char> &key, const std::string &value) {
+    append_bytes(key, value.size());
+    key.insert(key.end(), value.begin(), value.end());
+}
+
+// the type of a solver, scheme or mesh and the values of its cache_key(),
+// member by member, so padding never enters
+template <typename T>
+void append_cache_key(std::vector<char> &key, const T &value) {
+    if constexpr (std::is_arithmetic_v<T>) {
+        append_bytes(key, value);
+    }
+    else {
+        static_assert(CacheKeyed<T>, "cache_key: unsupported member");
+        append_bytes(key, std::string{typeid(T).name()});
+        if constexpr (requires { value.cache_key(); }) {
+            std::apply([&](const auto &...member) {
+                (append_cache_key(key, member), ...);
+            }, value.cache_key());
+        }
+    }
+}
+
+}  // namespace detail
+
+// solver.run(var, ex, t0, tend), served from the cache next to `output` when
+// the same run was done before; an empty output disables the cache
+template <typename SolverType, typename VarType, typename ExType>
+auto cached_run(const SolverType &solver, VarType var, ExType &ex, double t0,
+                double tend, const std::string &output)
+    -> flux::expected<VarType, std::string> {
+    if constexpr (!detail::cacheable<SolverType, ExType>()) {
+        return solver.run(std::move(var), ex, t0, tend);
+    }
+    else {
+        if (output.empty() || !detail::result_cache_enabled()) {
+            return solver.run(std::move(var), ex, t0, tend);
+        }
+
+        auto key = std::vector<char>{};
+        detail::append_bytes(key, detail::result_cache_version);
+        detail::append_cache_key(key, solver);
+        detail::append_cache_key(key, ex);
+        detail::append_bytes(key, t0);
+        detail::append_bytes(key, tend);
+        auto state = CheckpointIO<VarType>::save(var);
+        detail::append_bytes(key, state.size());
+        const auto *p = reinterpret_cast<const char *>(state.data());
+        key.insert(key.end(), p, p + state.size() * sizeof(double));
+
+        const auto hash = detail::fnv1a(key.data(), key.size());
+        char name[24];
+        std::snprintf(name, sizeof(name), "%016llx.ckpt",
+                      static_cast<unsigned long long>(hash));
+        const auto path =
+            std::filesystem::path(output).parent_path() / ".cache" / name;
+
+        // the tag, a hash of the key seeded with the file name, and tend
+        // guard against collisions of the file name
+        const auto tag = detail::fnv1a(key.data(), key.size(), hash);
+        if (auto hit = load_checkpoint<VarType>(path.string());
+            hit && hit.value().t == tend && hit.value().tag == tag) {
+            return std::move(hit.value().var);
+        }
+
+        auto result = solver.run(std::move(var), ex, t0, tend);
+        if (result) {
+            // a failed write only costs the next run a solve
+            std::error_code ec;
+            std::filesystem::create_directories(path.parent_path(), ec);
+            if (!ec) {
+                // the iterations of solver.run are not known here
+                static_cast<void>(save_checkpoint(path.string(), result.value(),
+                                                  tend, 0, tag));
+            }
+        }
+        return result;
+    }
+}
+
+}  // namespace flux
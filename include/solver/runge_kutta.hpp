@@ -0,0 +1,476 @@
+#pragma once
+
+// Explicit Runge-Kutta methods in Shu-Osher form as compile-time tableaux,
+// the step shared by the RKSolver of every framework and the in-place
+// stages (InPlaceStages) of the subdomain solvers:
+//
+//   u^(0) = u_n
+//   u^(i) = sum_{j < i} alpha[i-1][j] u^(j) + dt beta[i-1][j] L(u^(j))
+//   u_{n+1} = u^(s)
+//
+// With alpha, beta >= 0 a method is strong stability preserving (SSP) for
+// dt <= ssp * dt_FE, dt_FE the forward Euler limit; it costs `stages` op_L
+// calls per step, so ssp / stages is the step per op_L call. The solvers
+// take ssp times the dt of get_dt, which is meant to be the forward Euler
+// (and SSPRK3) limit.
+//
+// Each stage is one pass over the state: the terms with nonzero coefficients
+// are summed per element, zero ones are dropped at compile time, and stage
+// values and L are released after their last use.
+//
+// The stage limiter (post_process_rk_stage) runs after every stage, the one
+// stage of forward Euler included, in step() and InPlaceStages alike, so all
+// frameworks limit the same states.
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "profiler.hpp"
+#include "requires.h"
+
+namespace flux::rk {
+
+template <typename T>
+concept RKTableau = requires {
+    T::stages;
+    T::order;
+    T::ssp;
+    T::alpha;
+    T::beta;
+};
+
+template <std::size_t S>
+using Coefficients = std::array<std::array<double, S>, S>;
+
+// ssp = 1, 1 stage
+struct ForwardEuler {
+    static constexpr std::size_t stages = 1;
+    static constexpr std::size_t order = 1;
+    static constexpr double ssp = 1;
+    static constexpr Coefficients<1> alpha = {{{1}}};
+    static constexpr Coefficients<1> beta = {{{1}}};
+};
+
+// Shu and Osher (1988), ssp = 1, 1/3 per op_L
+struct SSPRK3 {
+    static constexpr std::size_t stages = 3;
+    static constexpr std::size_t order = 3;
+    static constexpr double ssp = 1;
+    static constexpr Coefficients<3> alpha = {{
+        {1, 0, 0},
+        {3.0 / 4, 1.0 / 4, 0},
+        {1.0 / 3, 0, 2.0 / 3},
+    }};
+    static constexpr Coefficients<3> beta = {{
+        {1, 0, 0},
+        {0, 1.0 / 4, 0},
+        {0, 0, 2.0 / 3},
+    }};
+};
+
+// Kraaijevanger (1991), SSPRK(n^2, 3) with n = 2, ssp = 2, 1/2 per op_L
+struct SSPRK43 {
+    static constexpr std::size_t stages = 4;
+    static constexpr std::size_t order = 3;
+    static constexpr double ssp = 2;
+    static constexpr Coefficients<4> alpha = {{
+        {1, 0, 0, 0},
+        {0, 1, 0, 0},
+        {2.0 / 3, 0, 1.0 / 3, 0},
+        {0, 0, 0, 1},
+    }};
+    static constexpr Coefficients<4> beta = {{
+        {1.0 / 2, 0, 0, 0},
+        {0, 1.0 / 2, 0, 0},
+        {0, 0, 1.0 / 6, 0},
+        {0, 0, 0, 1.0 / 2},
+    }};
+};
+
+// Spiteri and Ruuth (2002), ssp = 2.65, 0.53 per op_L; four beta refined
+// so that the order conditions hold in double precision
+struct SSPRK53 {
+    static constexpr std::size_t stages = 5;
+    static constexpr std::size_t order = 3;
+    static constexpr double ssp = 2.65062919294483;
+    static constexpr Coefficients<5> alpha = {{
+        {1, 0, 0, 0, 0},
+        {0, 1, 0, 0, 0},
+        {0.56656131914033, 0, 0.43343868085967, 0, 0},
+        {0.09299483444413, 0.00002090369620, 0, 0.90698426185967, 0},
+        {0.00736132260920, 0.20127980325145, 0.00182955389682, 0,
+         0.78952932024253},
+    }};
+    static constexpr Coefficients<5> beta = {{
+        {0.37726891511710, 0, 0, 0, 0},
+        {0, 0.37726891511710, 0, 0, 0},
+        {0, 0, 0.16352294286513092, 0, 0},
+        {0.00071997524034416, 0, 0, 0.3421769617580958, 0},
+        {0.00277719819460, 0.00001567934613, 0, 0, 0.2978648725436246},
+    }};
+};
+
+// Ketcheson (2008), ssp = 6, 3/5 per op_L, fourth order
+struct SSPRK104 {
+    static constexpr std::size_t stages = 10;
+    static constexpr std::size_t order = 4;
+    static constexpr double ssp = 6;
+    static constexpr Coefficients<10> alpha = [] {
+        Coefficients<10> a{};
+        for (std::size_t i = 0; i < 10; i++) a[i][i] = 1;
+        a[4] = {3.0 / 5, 0, 0, 0, 2.0 / 5};
+        a[9] = {1.0 / 25, 0, 0, 0, 9.0 / 25, 0, 0, 0, 0, 3.0 / 5};
+        return a;
+    }();
+    static constexpr Coefficients<10> beta = [] {
+        Coefficients<10> b{};
+        for (std::size_t i = 0; i < 10; i++) b[i][i] = 1.0 / 6;
+        b[4] = {0, 0, 0, 0, 1.0 / 15};
+        b[9] = {0, 0, 0, 0, 3.0 / 50, 0, 0, 0, 0, 1.0 / 10};
+        return b;
+    }();
+};
+
+namespace detail {
+template <RKTableau T>
+constexpr double alpha(std::size_t i, std::size_t j) {
+    return T::alpha[i - 1][j];
+}
+
+template <RKTableau T>
+constexpr double beta(std::size_t i, std::size_t j) {
+    return T::beta[i - 1][j];
+}
+}  // namespace detail
+
+// c[j]: u^(j) approximates u(t + c[j] dt)
+template <RKTableau T>
+constexpr std::array<double, T::stages + 1> stage_times() {
+    using detail::alpha, detail::beta;
+    std::array<double, T::stages + 1> c{};
+    for (std::size_t i = 1; i <= T::stages; i++) {
+        for (std::size_t j = 0; j < i; j++) {
+            c[i] += alpha<T>(i, j) * c[j] + beta<T>(i, j);
+        }
+    }
+    return c;
+}
+
+// b[j]: u_{n+1} = u_n + dt sum_j b[j] L(u^(j)) for a linear L, the weight of
+// the fluxes of stage j + 1 in the step (the Butcher weights)
+template <RKTableau T>
+constexpr std::array<double, T::stages> weights() {
+    using detail::alpha, detail::beta;
+    constexpr std::size_t S = T::stages;
+    // g[i][j]: coefficient of dt L(u^(j)) in u^(i)
+    std::array<std::array<double, S>, S + 1> g{};
+    for (std::size_t i = 1; i <= S; i++) {
+        for (std::size_t j = 0; j < i; j++) {
+            g[i][j] += beta<T>(i, j);
+            for (std::size_t m = j + 1; m < i; m++) {
+                g[i][j] += alpha<T>(i, m) * g[m][j];
+            }
+        }
+    }
+    return g[S];
+}
+
+namespace detail {
+// the last stage reading u^(j) (value) or L(u^(j)) (rate), 0 if none
+template <RKTableau T>
+constexpr std::array<std::size_t, T::stages> last_use(bool rate) {
+    std::array<std::size_t, T::stages> last{};
+    for (std::size_t i = 1; i <= T::stages; i++) {
+        for (std::size_t j = 0; j < i; j++) {
+            if ((rate ? beta<T>(i, j) : alpha<T>(i, j)) != 0) last[j] = i;
+        }
+    }
+    return last;
+}
+
+// the rows sum to one, so that constants are kept
+template <RKTableau T>
+constexpr bool consistent() {
+    for (std::size_t i = 1; i <= T::stages; i++) {
+        double sum = 0;
+        for (std::size_t j = 0; j < i; j++) sum += alpha<T>(i, j);
+        if (sum - 1 > 1e-13 || 1 - sum > 1e-13) return false;
+    }
+    return true;
+}
+
+// operands read by stage i
+template <RKTableau T, std::size_t I>
+constexpr std::size_t reads() {
+    std::size_t n = 0;
+    for (std::size_t j = 0; j < I; j++) {
+        n += (alpha<T>(I, j) != 0 ? std::size_t{1} : std::size_t{0})
+             + (beta<T>(I, j) != 0 ? std::size_t{1} : std::size_t{0});
+    }
+    return n;
+}
+
+template <typename VarType>
+concept FlatVar = requires(VarType v) {
+    v.data.size();
+    v.data.data();
+    VarType(std::move(v.data));
+};
+
+// an operand that stage I reads for the last time, {rate, j} for L(u^(j))
+// or u^(j); its storage takes the result. j = I if there is none
+template <RKTableau T, std::size_t I>
+constexpr std::pair<bool, std::size_t> dying_operand() {
+    const auto last_value = last_use<T>(false);
+    const auto last_rate = last_use<T>(true);
+    for (std::size_t j = 0; j < I; j++) {
+        if (last_rate[j] == I) return {true, j};
+    }
+    for (std::size_t j = 0; j < I; j++) {
+        if (last_value[j] == I) return {false, j};
+    }
+    return {false, I};
+}
+
+template <typename VarType, std::size_t S>
+using Slots = std::array<std::optional<VarType>, S>;
+
+// term j of stage i at element k, a * (u + dt b / a * L) when both are
+// nonzero, the grouping of the hand-written SSPRK3
+template <RKTableau T, std::size_t I, std::size_t J, typename Ptr>
+void add_term(double &acc, Ptr u, Ptr L, double dt, std::size_t k) {
+    constexpr double a = alpha<T>(I, J);
+    constexpr double b = beta<T>(I, J);
+    if constexpr (a != 0 && b != 0) {
+        acc += a * (u[k] + dt * (b / a) * L[k]);
+    }
+    else if constexpr (a != 0) {
+        acc += a * u[k];
+    }
+    else if constexpr (b != 0) {
+        acc += dt * b * L[k];
+    }
+}
+
+// the same on whole states, for types without a flat data vector
+template <RKTableau T, std::size_t I, std::size_t J, typename VarType>
+void add_term(std::optional<VarType> &acc,
+              const Slots<VarType, T::stages + 1> &u,
+              const Slots<VarType, T::stages> &L, double dt) {
+    constexpr double a = alpha<T>(I, J);
+    constexpr double b = beta<T>(I, J);
+    auto add = [&](VarType term) {
+        acc = acc ? VarType(*acc + term) : std::move(term);
+    };
+    if constexpr (a != 0 && b != 0) {
+        add(a * (*u[J] + dt * (b / a) * *L[J]));
+    }
+    else if constexpr (a != 0) {
+        add(a * *u[J]);
+    }
+    else if constexpr (b != 0) {
+        add(dt * b * *L[J]);
+    }
+}
+
+}  // namespace detail
+
+// stage I of T on arrays of n values, out = sum_j alpha u[j] + dt beta L[j]
+// grouped as in step(). Element k of out is written after its operands are
+// read, so out may be one of them; operands with zero coefficients are not
+// read and may be null.
+template <RKTableau T, std::size_t I, typename Value>
+void combine_stage(Value *out, const std::array<const Value *, I> &u,
+                   const std::array<const Value *, I> &L, double dt,
+                   std::size_t n) {
+    [&]<std::size_t... J>(std::index_sequence<J...>) {
+        for (std::size_t k = 0; k < n; k++) {
+            double acc = 0;
+            (detail::add_term<T, I, J>(acc, u[J], L[J], dt, k), ...);
+            out[k] = static_cast<Value>(acc);
+        }
+    }(std::make_index_sequence<I>{});
+}
+
+// f(std::integral_constant<std::size_t, i>{}) for the stages i = 1, ..., s
+template <RKTableau T, typename F>
+void for_each_stage(F &&f) {
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        (f(std::integral_constant<std::size_t, I + 1>{}), ...);
+    }(std::make_index_sequence<T::stages>{});
+}
+
+namespace detail {
+template <RKTableau T, std::size_t I, VarRequirements VarType>
+VarType combine(Slots<VarType, T::stages + 1> &u,
+                Slots<VarType, T::stages> &L, double dt) {
+    return [&]<std::size_t... J>(std::index_sequence<J...>) {
+        if constexpr (FlatVar<VarType>) {
+            using Data = decltype(VarType::data);
+            using Value = typename Data::value_type;
+            auto ptr = [](const auto &slot) -> const Value * {
+                return slot ? slot->data.data() : nullptr;
+            };
+            const std::array<const Value *, I> up = {ptr(u[J])...};
+            const std::array<const Value *, I> Lp = {ptr(L[J])...};
+            const std::size_t n = u[I - 1]->data.size();
+
+            // the result may overwrite a dying operand in place
+            constexpr auto dying = dying_operand<T, I>();
+            Data data;
+            if constexpr (dying.second == I) {
+                data = Data(n);
+            }
+            else if constexpr (dying.first) {
+                data = std::move(L[dying.second]->data);
+            }
+            else {
+                data = std::move(u[dying.second]->data);
+            }
+
+            combine_stage<T, I>(data.data(), up, Lp, dt, n);
+            return VarType(std::move(data));
+        }
+        else {
+            std::optional<VarType> acc;
+            (add_term<T, I, J>(acc, u, L, dt), ...);
+            return std::move(*acc);
+        }
+    }(std::make_index_sequence<I>{});
+}
+}  // namespace detail
+
+// one step of size dt from var_n at time t; op_L(var, t) and
+// post_process_rk_stage(var, t) are the framework's callbacks, both called
+// with the time of the stage's input u^(i-1); post_process_rk_stage runs
+// after every stage
+template <RKTableau T, VarRequirements VarType, typename OpL,
+          typename PostStage>
+VarType step(const VarType &var_n, double t, double dt, OpL &&op_L,
+             PostStage &&post_process_rk_stage) {
+    static_assert(detail::consistent<T>(), "rows of alpha must sum to one");
+    constexpr std::size_t S = T::stages;
+    constexpr auto c = stage_times<T>();
+    constexpr auto last_value = detail::last_use<T>(false);
+    constexpr auto last_rate = detail::last_use<T>(true);
+
+    detail::Slots<VarType, S + 1> u;
+    detail::Slots<VarType, S> L;
+    u[0] = var_n;
+
+    // stage i: L of u^(i-1) if used, then u^(i)
+    for_each_stage<T>([&](auto stage) {
+        constexpr std::size_t i = decltype(stage)::value;
+        const auto &prev = *u[i - 1];
+        if constexpr (last_rate[i - 1] != 0) {
+            L[i - 1] = FLUX_PROFILE_CALL(op_L, 2 * profile::bytes_of(prev),
+                                         op_L(prev, t + c[i - 1] * dt));
+        }
+
+        VarType next = FLUX_PROFILE_CALL(
+            rk_combine, (detail::reads<T, i>() + 1) * profile::bytes_of(prev),
+            detail::combine<T, i>(u, L, dt));
+        u[i] = FLUX_PROFILE_CALL(
+            post_process_rk_stage, 2 * profile::bytes_of(next),
+            post_process_rk_stage(next, t + c[i - 1] * dt));
+
+        for (std::size_t j = 0; j < i; j++) {
+            if (last_value[j] <= i) u[j].reset();
+            if (last_rate[j] <= i) L[j].reset();
+        }
+    });
+
+    return std::move(*u[S]);
+}
+
+// the post_process_rk_stage of InPlaceStages without a stage limiter
+struct NoStageLimiter {
+    void operator()() const {}
+};
+
+// The stages of T on a state of n values that the solver updates in place
+// (the subdomain solvers): w holds u^(i-1) when stage i starts, its op_L
+// goes to rate(i) and update<i> turns w into u^(i). Only the values and
+// rates that are read after the next stage get a register of their own, the
+// other rates share one: SSPRK3 keeps u_n and one L, forward Euler one L.
+// u^(j) is saved by the update of stage j + 1, after the solver's stage
+// limiter.
+template <RKTableau T>
+class InPlaceStages {
+public:
+    // keep_start: keep u_n for start() even if no stage reads it again
+    explicit InPlaceStages(std::size_t n, bool keep_start = false) : m_n(n) {
+        for (std::size_t j = 0; j < T::stages; j++) {
+            if (saved(j) || (j == 0 && keep_start)) m_values[j].resize(n);
+            if (own_rate(j)) m_rates[j].resize(n);
+        }
+        m_rate.resize(n);
+    }
+
+    // whether stage i reads L(u^(i-1)), else its op_L can be skipped
+    static constexpr bool uses_rate(std::size_t i) {
+        return last_rate[i - 1] != 0;
+    }
+
+    // where the op_L of stage i goes
+    std::vector<double> &rate(std::size_t i) {
+        return own_rate(i - 1) ? m_rates[i - 1] : m_rate;
+    }
+
+    // u_n of the current step, once stage 1 is updated
+    const std::vector<double> &start() const { return m_values[0]; }
+
+    // w = u^(I) from u^(I-1) in w, the saved values and the rates, then
+    // post_process_rk_stage(), the solver's stage limiter on w, as in step()
+    template <std::size_t I, typename PostStage = NoStageLimiter>
+    void update(double *w, double dt, PostStage &&post_process_rk_stage = {}) {
+        update<I>(w, dt, 0, m_n, post_process_rk_stage);
+    }
+
+    // the same on the elements [first, last) of w and the registers (the
+    // tiles of solver_blocked, whose ranges shrink from stage to stage)
+    template <std::size_t I, typename PostStage = NoStageLimiter>
+    void update(double *w, double dt, std::size_t first, std::size_t last,
+                PostStage &&post_process_rk_stage = {}) {
+        auto at = [&](std::vector<double> &v) -> double * {
+            return v.empty() ? nullptr : v.data() + first;
+        };
+        if (!m_values[I - 1].empty()) {
+            std::copy(w + first, w + last, at(m_values[I - 1]));
+        }
+
+        std::array<const double *, I> u{};
+        std::array<const double *, I> L{};
+        for (std::size_t j = 0; j < I; j++) {
+            u[j] = j + 1 == I ? w + first : at(m_values[j]);
+            L[j] = at(rate(j + 1));
+        }
+        combine_stage<T, I>(w + first, u, L, dt, last - first);
+        post_process_rk_stage();
+    }
+
+private:
+    static constexpr auto last_value = detail::last_use<T>(false);
+    static constexpr auto last_rate = detail::last_use<T>(true);
+
+    // u^(j) is read after stage j + 1, where it is w
+    static constexpr bool saved(std::size_t j) {
+        return last_value[j] > j + 1;
+    }
+
+    static constexpr bool own_rate(std::size_t j) {
+        return last_rate[j] > j + 1;
+    }
+
+    std::size_t m_n;
+    std::array<std::vector<double>, T::stages> m_values;
+    std::array<std::vector<double>, T::stages> m_rates;
+    std::vector<double> m_rate;  // shared by the rates read by one stage
+};
+
+}  // namespace flux::rk
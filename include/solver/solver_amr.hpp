@@ -0,0 +1,157 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "amr/grid.hpp"
+#include "expected.hpp"
+#include "preset.hpp"
+#include "runge_kutta.hpp"
+#include "subdomain_scheme.hpp"
+
+namespace flux::solver_amr {
+
+// Time integration of a 1d finite volume scheme on an amr::Grid. Every block
+// is a padded slice for the scheme kernels at the cell width of its level.
+// At a coarse-fine face the coarse cell takes the flux of the fine block
+// (refluxing), so every face has a single flux and the scheme stays
+// conservative. All levels advance with the dt of the finest level and the
+// stages of the tableau Tableau (runge_kutta.hpp), the grid is adapted every
+// `interval` steps.
+template <ConservativeScheme Scheme, rk::RKTableau Tableau>
+class Solver {
+public:
+    static constexpr size_t halo = Scheme::halo;  // of the grid
+
+    explicit Solver(Scheme scheme, amr::RegridConfig regrid = {})
+        : m_scheme(std::move(scheme)), m_regrid(regrid) {}
+
+    const amr::RegridConfig &regrid() const { return m_regrid; }
+
+    // one regrid pass, e.g. to refine the initial data
+    void adapt(amr::Grid &grid) const { grid.adapt(m_regrid); }
+
+    auto run(amr::Grid grid, double t0,
+             double tend) const -> flux::expected<amr::Grid, std::string> {
+        size_t cell_updates = 0;
+        return run(std::move(grid), t0, tend, cell_updates);
+    }
+
+    // cell_updates: the cell steps of the run
+    auto run(amr::Grid grid, double t0, double tend, size_t &cell_updates) const
+        -> flux::expected<amr::Grid, std::string> {
+        cell_updates = 0;
+        if (grid.halo() != Scheme::halo) {
+            return flux::unexpected{
+                std::string{"solver_amr: grid halo does not match the scheme"}};
+        }
+        if (tend <= t0) return grid;
+
+        if (!time_loop(grid, t0, tend, cell_updates)) {
+            return flux::unexpected{std::string{"Iteration exceeds"}};
+        }
+        return grid;
+    }
+
+private:
+    bool time_loop(amr::Grid &grid, double t, double tend,
+                   size_t &cell_updates) const {
+        const size_t n = grid.block();
+        auto &blocks = grid.blocks();
+
+        using Stages = rk::InPlaceStages<Tableau>;
+        std::vector<Stages> stages;
+        auto resize = [&]() { stages.resize(blocks.size(), Stages(n)); };
+        resize();
+
+        auto speed = [&]() {
+            double df_max = 0;
+            for (const auto &b : blocks) {
+                auto ex = Mesh1d{grid.dx(b.level)};
+                df_max = std::max(df_max,
+                                  m_scheme.max_speed(b.u, ex, halo, halo + n));
+            }
+            return df_max;
+        };
+
+        // coarse cells next to a finer block take its face flux
+        auto reflux = [&](double df_max, size_t i) {
+            const size_t nb = blocks.size();
+            for (size_t k = 0; k < nb; k++) {
+                size_t r = (k + 1) % nb;
+                const auto &bl = blocks[k];
+                const auto &br = blocks[r];
+                if (bl.level == br.level) continue;
+
+                double fl = m_scheme.face_flux(bl.u, df_max, n);
+                double fr = m_scheme.face_flux(br.u, df_max, 0);
+                if (bl.level < br.level) {
+                    stages[k].rate(i)[n - 1] += (fl - fr) / grid.dx(bl.level);
+                }
+                else {
+                    stages[r].rate(i)[0] += (fl - fr) / grid.dx(br.level);
+                }
+            }
+        };
+
+        // the op_L of stage i on every block
+        auto apply_op_L = [&](double df_max, size_t i) {
+            grid.fill_ghosts();
+            for (size_t k = 0; k < blocks.size(); k++) {
+                auto ex = Mesh1d{grid.dx(blocks[k].level)};
+                m_scheme.op_L(blocks[k].u, df_max, ex, stages[k].rate(i), 0,
+                              n);
+            }
+            reflux(df_max, i);
+        };
+
+        bool stop_flag = false;
+        constexpr auto iter_max = std::numeric_limits<size_t>::max();
+        for (size_t iter = 0; iter < iter_max && (!stop_flag); ++iter) {
+            if (iter > 0 && m_regrid.interval > 0
+                && iter % m_regrid.interval == 0) {
+                grid.adapt(m_regrid);
+                resize();
+            }
+
+            double df_max = speed();
+            auto finest = Mesh1d{grid.dx(grid.finest_level())};
+            double dt = Tableau::ssp * m_scheme.dt(df_max, finest);
+            if (t + dt >= tend && t < tend) {
+                dt = tend - t;
+                stop_flag = true;
+            }
+
+            rk::for_each_stage<Tableau>([&](auto stage) {
+                constexpr size_t i = decltype(stage)::value;
+                if constexpr (Stages::uses_rate(i)) {
+                    bool fresh = i > 1 && Scheme::stage_speed;  // speed of w
+                    apply_op_L(fresh ? speed() : df_max, i);
+                }
+                for (size_t k = 0; k < blocks.size(); k++) {
+                    stages[k].template update<i>(blocks[k].u.data() + halo,
+                                                 dt);
+                }
+            });
+
+            cell_updates += blocks.size() * n;
+            t += dt;
+        }
+        return stop_flag;
+    }
+
+    Scheme m_scheme;
+    amr::RegridConfig m_regrid;
+};
+
+template <ConservativeScheme Scheme>
+using EulerSolver = Solver<Scheme, rk::ForwardEuler>;
+
+template <ConservativeScheme Scheme>
+using RK3Solver = Solver<Scheme, rk::SSPRK3>;
+
+}  // namespace flux::solver_amr
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "expected.hpp"
+#include "parallel/thread_team.hpp"
+#include "preset.hpp"
+#include "runge_kutta.hpp"
+#include "subdomain_scheme.hpp"
+
+namespace flux::solver_blocked {
+
+// Time integration of a periodic grid by temporal blocking: every stage of
+// a step is run on a tile of `tile` cells before moving to the next tile, so
+// the tile stays in cache across the stages and the state is read and
+// written once per step instead of once per stage.
+//
+// A tile gathers its cells and stages * g ghost cells on each side from the
+// state, g = halo, or 2 * halo with a stage limiter, which reads halo more
+// cells after op_L. Each stage of the tableau Tableau (InPlaceStages of
+// runge_kutta.hpp) updates g fewer cells on each side than the one before,
+// recomputing the ghost cells the neighbouring tiles also compute. The speed
+// of the next dt is taken from the new cells of the tile while they are in
+// cache. The tiles are dealt over a ThreadTeam in contiguous ranges. Every
+// cell sees the same operations as in solver_threads, so the result is
+// bitwise identical.
+//
+// dt is fixed within a step: schemes needing the speed at every stage
+// (stage_speed) would need a reduction over all tiles between two stages,
+// which is what blocking removes, so they are not supported.
+template <SubdomainScheme Scheme, rk::RKTableau Tableau>
+    requires(!Scheme::stage_speed)
+class Solver {
+public:
+    using ExType = typename Scheme::mesh_type;
+
+    static constexpr std::size_t default_tile = 4096;
+
+    explicit Solver(Scheme scheme, std::size_t tile = default_tile,
+                    std::size_t threads = parallel::default_thread_count(),
+                    bool pin = true)
+        : m_scheme(std::move(scheme)), m_tile(std::max<std::size_t>(tile, 1)),
+          m_team(std::make_shared<parallel::ThreadTeam>(threads, pin)) {}
+
+    std::size_t threads() const { return m_team->size(); }
+
+    std::size_t tile() const { return m_tile; }
+
+    auto run(Vec var, ExType &ex, double t0,
+             double tend) const -> flux::expected<Vec, std::string> {
+        if (tend <= t0) return var;
+
+        if (var.data.empty()) {
+            return flux::unexpected{std::string{"solver_blocked: no cells"}};
+        }
+
+        auto next = std::vector<double>(var.data.size());
+        bool stop_flag = false;
+        bool swapped = false;
+        m_team->run([&](std::size_t tid) {
+            auto *cur = &var.data;
+            auto *new_state = &next;
+            bool stop = time_loop(cur, new_state, tid, ex, t0, tend);
+            if (tid == 0) {  // the same on every thread
+                stop_flag = stop;
+                swapped = cur != &var.data;
+            }
+        });
+        if (swapped) var.data = std::move(next);
+
+        if (!stop_flag) {
+            return flux::unexpected{std::string{"Iteration exceeds"}};
+        }
+        return var;
+    }
+
+private:
+    bool stage_limiter() const {
+        if constexpr (SubdomainStageLimiter<Scheme>) {
+            return m_scheme.stage_limiter();
+        }
+        else {
+            return false;
+        }
+    }
+
+    bool time_loop(std::vector<double> *&cur, std::vector<double> *&next,
+                   std::size_t tid, const ExType &ex, double t,
+                   double tend) const {
+        auto &team = *m_team;
+        const std::size_t block = m_scheme.block(ex);
+        const std::size_t n = cur->size() / block;
+        const std::size_t tiles = (n + m_tile - 1) / m_tile;
+        const std::size_t tile_first = tiles * tid / team.size();
+        const std::size_t tile_last = tiles * (tid + 1) / team.size();
+        const std::size_t h = Scheme::halo;
+        const bool limit = stage_limiter();
+        const std::size_t g = limit ? 2 * h : h;  // cells lost per stage
+        const std::size_t pad = Tableau::stages * g;
+        const std::size_t width = m_tile + 2 * pad;
+
+        // scratch of a tile, first touched by this thread. w holds the cells
+        // begin - pad, ... of the tile, u is w behind h more cells: the
+        // padded slice of op_L and of the limiter, whose owned cell k is
+        // cell k of w, the rates and limited
+        using Stages = rk::InPlaceStages<Tableau>;
+        auto u = std::vector<double>((h + width) * block);
+        double *w = u.data() + h * block;
+        auto stages = Stages(width * block);
+        auto limited = std::vector<double>(limit ? width * block : 0);
+
+        // cells [lo, hi) of w
+        auto apply_stage_limiter = [&](std::size_t lo, std::size_t hi) {
+            if constexpr (SubdomainStageLimiter<Scheme>) {
+                if (!limit) return;
+
+                m_scheme.post_process_rk_stage(u, ex, limited, lo, hi);
+                std::copy(limited.begin()
+                              + static_cast<std::ptrdiff_t>(lo * block),
+                          limited.begin()
+                              + static_cast<std::ptrdiff_t>(hi * block),
+                          w + lo * block);
+            }
+        };
+
+        // cells [begin, end) of the new state from the current one, returns
+        // the max speed of the new cells
+        auto advance = [&](std::size_t begin, std::size_t end, double df_max,
+                           double dt) {
+            const std::size_t cells = end - begin + 2 * pad;
+            // contiguous runs, wrapping around the periodic state
+            std::size_t src = (begin + n * (pad / n + 1) - pad) % n;
+            for (std::size_t k = 0; k < cells;) {
+                std::size_t count = std::min(cells - k, n - src);
+                std::copy_n(cur->data() + src * block, count * block,
+                            w + k * block);
+                k += count;
+                src = 0;
+            }
+
+            rk::for_each_stage<Tableau>([&](auto stage) {
+                constexpr std::size_t i = decltype(stage)::value;
+                // the cells of w that op_L and the update of stage i reach
+                const std::size_t lo = (i - 1) * g + h;
+                const std::size_t hi = cells - lo;
+                if constexpr (Stages::uses_rate(i)) {
+                    m_scheme.op_L(u, df_max, ex, stages.rate(i), lo, hi);
+                }
+                stages.template update<i>(w, dt, lo * block, hi * block, [&] {
+                    apply_stage_limiter(lo + h, hi - h);
+                });
+            });
+
+            std::copy_n(w + pad * block, (end - begin) * block,
+                        next->data() + begin * block);
+            return m_scheme.max_speed(*next, ex, begin, end);
+        };
+
+        auto tile_end = [&](std::size_t k) {
+            return std::min(n, (k + 1) * m_tile);
+        };
+
+        double local = 0;
+        for (std::size_t k = tile_first; k < tile_last; k++) {
+            double s = m_scheme.max_speed(*cur, ex, k * m_tile, tile_end(k));
+            local = std::max(local, s);
+        }
+
+        bool stop_flag = false;
+        constexpr auto iter_max = std::numeric_limits<std::size_t>::max();
+        for (std::size_t iter = 0; iter < iter_max && (!stop_flag); ++iter) {
+            // also waits until every tile of the last step is written
+            double df_max = team.reduce_max(tid, local);
+            double dt = Tableau::ssp * m_scheme.dt(df_max, ex);
+            if (t + dt >= tend && t < tend) {
+                dt = tend - t;
+                stop_flag = true;
+            }
+
+            local = 0;
+            for (std::size_t k = tile_first; k < tile_last; k++) {
+                double s = advance(k * m_tile, tile_end(k), df_max, dt);
+                local = std::max(local, s);
+            }
+            std::swap(cur, next);
+
+            t += dt;
+        }
+        team.barrier();  // the last step is complete
+        return stop_flag;
+    }
+
+    Scheme m_scheme;
+    std::size_t m_tile;
+    std::shared_ptr<parallel::ThreadTeam> m_team;  // shared by copies
+};
+
+template <SubdomainScheme Scheme>
+using EulerSolver = Solver<Scheme, rk::ForwardEuler>;
+
+template <SubdomainScheme Scheme>
+using RK3Solver = Solver<Scheme, rk::SSPRK3>;
+
+}  // namespace flux::solver_blocked
@@ -2,9 +2,13 @@
 
 #include <limits>
 #include <string>
+#include <utility>
 
+#include "checkpoint.hpp"
 #include "expected.hpp"
+#include "profiler.hpp"
 #include "requires.h"
+#include "runge_kutta.hpp"
 
 namespace flux::solver_deducing {
 
@@ -13,9 +17,11 @@ class Solver {
 public:
     auto run(this const auto &self, VarType var, ExType &ex, double t0,
              double tend) -> flux::expected<VarType, std::string> {
+        FLUX_PROFILE_RUN();
+
         if (tend <= t0) return var;
 
-        double t = 0;
+        double t = t0;
         bool stop_flag = false;
         constexpr auto iter_max = std::numeric_limits<std::size_t>::max();
         for (size_t iter = 0; iter < iter_max && (!stop_flag); ++iter) {
@@ -25,6 +31,32 @@ public:
 
         return var;
     }
+
+    // run with periodic checkpoints, see checkpoint.hpp
+    auto run(this const auto &self, VarType var, ExType &ex, double t0,
+             double tend, const CheckpointConfig &cfg)
+        -> flux::expected<VarType, std::string> {
+        return run_with_checkpoint(
+            std::move(var), t0, 0, tend, cfg,
+            [&](const VarType &v, double &t, bool &stop_flag) {
+                return self.update(v, ex, t, stop_flag, tend);
+            });
+    }
+
+    // resume from cfg.path, keep writing checkpoints to it
+    auto run_from_checkpoint(this const auto &self, ExType &ex, double tend,
+                             const CheckpointConfig &cfg)
+        -> flux::expected<VarType, std::string> {
+        auto ckpt = load_checkpoint<VarType>(cfg.path);
+        if (!ckpt) { return flux::unexpected{ckpt.error()}; }
+
+        auto &state = ckpt.value();
+        return run_with_checkpoint(
+            std::move(state.var), state.t, state.iter, tend, cfg,
+            [&](const VarType &v, double &t, bool &stop_flag) {
+                return self.update(v, ex, t, stop_flag, tend);
+            });
+    }
 };
 
 template <VarRequirements VarType, typename ExType>
@@ -32,17 +64,24 @@ class EulerSolver : public Solver<VarType, ExType> {
 public:
     VarType update(this const auto &self, const VarType &var, ExType &ex,
                    double &t, bool &stop_flag, double tend) {
-        double dt = self.get_dt(var, ex, t);
+        double dt = FLUX_PROFILE_CALL(get_dt, profile::bytes_of(var),
+                                      self.get_dt(var, ex, t));
         if (t + dt >= tend && t < tend) {
             dt = tend - t;
             stop_flag = true;
         }
 
-        auto var_n = self.pre_process(var, ex, t);
+        auto var_n = FLUX_PROFILE_CALL(pre_process, 2 * profile::bytes_of(var),
+                                       self.pre_process(var, ex, t));
 
-        VarType var2 = var_n + dt * self.op_L(var_n, ex, t);
+        VarType L0 = FLUX_PROFILE_CALL(op_L, 2 * profile::bytes_of(var_n),
+                                       self.op_L(var_n, ex, t));
+        VarType var2 = FLUX_PROFILE_CALL(
+            rk_combine, 3 * profile::bytes_of(var_n),
+            var_n + dt * L0);
 
-        var2 = self.post_process(var2, ex, t);
+        var2 = FLUX_PROFILE_CALL(post_process, 2 * profile::bytes_of(var2),
+                                 self.post_process(var2, ex, t));
 
         t += dt;
         return var2;
@@ -57,38 +96,36 @@ public:
     }
 };
 
-template <VarRequirements VarType, typename ExType>
-class RK3Solver : public Solver<VarType, ExType> {
+// explicit Runge-Kutta with the Shu-Osher tableau Tableau of
+// runge_kutta.hpp, dt is Tableau::ssp times get_dt
+template <rk::RKTableau Tableau, VarRequirements VarType, typename ExType>
+class RKSolver : public Solver<VarType, ExType> {
 public:
     VarType update(this const auto &self, const VarType &var, ExType &ex,
                    double &t, bool &stop_flag, double tend) {
-        double dt = self.get_dt(var, ex, t);
+        double dt = Tableau::ssp
+                    * FLUX_PROFILE_CALL(get_dt, profile::bytes_of(var),
+                                        self.get_dt(var, ex, t));
         if (t + dt >= tend && t < tend) {
             dt = tend - t;
             stop_flag = true;
         }
 
-        auto var_n = self.pre_process(var, ex, t);
-
-        VarType var1 = var_n + dt * self.op_L(var_n, ex, t);
+        auto var_n = FLUX_PROFILE_CALL(pre_process, 2 * profile::bytes_of(var),
+                                       self.pre_process(var, ex, t));
 
-        var1 = self.post_process_rk_stage(var1, ex, t);
+        VarType var2 = rk::step<Tableau>(
+            var_n, t, dt,
+            [&](const VarType &v, double tau) { return self.op_L(v, ex, tau); },
+            [&](const VarType &v, double tau) {
+                return self.post_process_rk_stage(v, ex, tau);
+            });
 
-        VarType var2 = (3.0 / 4) * var_n
-                       + (1.0 / 4) * (var1 + dt * self.op_L(var1, ex, t + dt));
-
-        var2 = self.post_process_rk_stage(var2, ex, t + dt);
-
-        VarType var3 =
-            (1.0 / 3) * var_n
-            + (2.0 / 3) * (var2 + dt * self.op_L(var2, ex, t + dt / 2));
-
-        var3 = self.post_process_rk_stage(var3, ex, t + dt / 2);
-
-        var3 = self.post_process(var3, ex, t + dt);
+        var2 = FLUX_PROFILE_CALL(post_process, 2 * profile::bytes_of(var2),
+                                 self.post_process(var2, ex, t + dt));
 
         t += dt;
-        return var3;
+        return var2;
     }
 
     VarType post_process(const VarType &var, ExType &ex, double t) const {
@@ -104,4 +141,7 @@ public:
         return var;
     }
 };
+
+template <VarRequirements VarType, typename ExType>
+using RK3Solver = RKSolver<rk::SSPRK3, VarType, ExType>;
 }  // namespace flux::solver_deducing
@@ -0,0 +1,302 @@
+#pragma once
+
+// Implicit and linearly implicit time integrators in the crtp framework, for
+// steps far above the explicit CFL limit. They reuse the derived solver's
+// op_L through the Jacobian-free Newton-Krylov kernels of newton_krylov.hpp:
+//
+//   DIRKSolver<BackwardEuler | SDIRK2 | SDIRK3, Derived>
+//       L-stable singly diagonally implicit RK, each stage solved by Newton
+//   RosenbrockSolver<Derived>
+//       ROS2 (Verwer et al. 1999), two linear solves per step, no Newton
+//
+// Derived provides get_dt and op_L like for RK3Solver, and may override
+// newton_krylov_config(ex) to set the block size of the block-Jacobi
+// preconditioner (DG_k + 1 for DG) and the tolerances. The preconditioner is
+// rebuilt at the start of every step from the diagonal blocks of
+// I - gamma dt J(u_n). A Newton or GMRES solve that does not converge ends
+// the run with an error, a smaller dt may succeed.
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <utility>
+
+#include "checkpoint.hpp"
+#include "expected.hpp"
+#include "newton_krylov.hpp"
+#include "preset.hpp"
+
+namespace flux::solver_implicit {
+
+using implicit::NewtonKrylovConfig;
+using implicit::Vector;
+
+// Butcher tableaux, lower triangular with the constant diagonal gamma
+template <typename T>
+concept DIRKTableau = requires {
+    T::stages;
+    T::gamma;
+    T::a;
+    T::b;
+    T::c;
+};
+
+struct BackwardEuler {
+    static constexpr size_t stages = 1;
+    static constexpr double gamma = 1;
+    static constexpr std::array<std::array<double, 1>, 1> a = {{{1}}};
+    static constexpr std::array<double, 1> b = {1};
+    static constexpr std::array<double, 1> c = {1};
+};
+
+// Alexander (1977), order 2, gamma = 1 - 1/sqrt(2)
+struct SDIRK2 {
+    static constexpr size_t stages = 2;
+    static constexpr double gamma = 0.29289321881345248;
+    static constexpr std::array<std::array<double, 2>, 2> a = {{
+        {gamma, 0},
+        {1 - gamma, gamma},
+    }};
+    static constexpr std::array<double, 2> b = {1 - gamma, gamma};
+    static constexpr std::array<double, 2> c = {gamma, 1};
+};
+
+// Alexander (1977), order 3, gamma the root of x^3 - 3x^2 + 3x/2 - 1/6
+// in (1/6, 1/2)
+struct SDIRK3 {
+    static constexpr size_t stages = 3;
+    static constexpr double gamma = 0.43586652150845900;
+    static constexpr double tau = (1 + gamma) / 2;
+    static constexpr double b1 = -(6 * gamma * gamma - 16 * gamma + 1) / 4;
+    static constexpr double b2 = (6 * gamma * gamma - 20 * gamma + 5) / 4;
+    static constexpr std::array<std::array<double, 3>, 3> a = {{
+        {gamma, 0, 0},
+        {tau - gamma, gamma, 0},
+        {b1, b2, gamma},
+    }};
+    static constexpr std::array<double, 3> b = {b1, b2, gamma};
+    static constexpr std::array<double, 3> c = {gamma, tau, 1};
+};
+
+// work of the nonlinear and linear solves of a run
+struct ImplicitStats {
+    size_t steps{0};
+    size_t newton_iterations{0};
+    size_t krylov_iterations{0};
+};
+
+template <typename Derived>
+class ImplicitSolverBase {
+public:
+    auto run(Vec var, Mesh1d &ex, double t0, double tend) const
+        -> flux::expected<Vec, std::string> {
+        auto stats = ImplicitStats{};
+        return run(std::move(var), ex, t0, tend, stats);
+    }
+
+    // the same, adding the work of the solves to stats
+    auto run(Vec var, Mesh1d &ex, double t0, double tend,
+             ImplicitStats &stats) const -> flux::expected<Vec, std::string> {
+        return run_with_checkpoint(std::move(var), t0, 0, tend, {},
+                                   updater(ex, tend, stats));
+    }
+
+    // run with periodic checkpoints, see checkpoint.hpp
+    auto run(Vec var, Mesh1d &ex, double t0, double tend,
+             const CheckpointConfig &cfg) const
+        -> flux::expected<Vec, std::string> {
+        auto stats = ImplicitStats{};
+        return run_with_checkpoint(std::move(var), t0, 0, tend, cfg,
+                                   updater(ex, tend, stats));
+    }
+
+    // resume from cfg.path, keep writing checkpoints to it
+    auto run_from_checkpoint(Mesh1d &ex, double tend,
+                             const CheckpointConfig &cfg) const
+        -> flux::expected<Vec, std::string> {
+        auto ckpt = load_checkpoint<Vec>(cfg.path);
+        if (!ckpt) { return flux::unexpected{ckpt.error()}; }
+
+        auto &state = ckpt.value();
+        auto stats = ImplicitStats{};
+        return run_with_checkpoint(std::move(state.var), state.t, state.iter,
+                                   tend, cfg, updater(ex, tend, stats));
+    }
+
+    NewtonKrylovConfig newton_krylov_config(const Mesh1d &ex) const {
+        return {};
+    }
+
+    Vec post_process(const Vec &var, Mesh1d &ex, double t) const {
+        return var;
+    }
+
+    Vec pre_process(const Vec &var, Mesh1d &ex, double t) const {
+        return var;
+    }
+
+protected:
+    constexpr const Derived &derived() const {
+        return static_cast<const Derived &>(*this);
+    }
+
+    // dt of this step, cut at tend like the explicit solvers
+    double step_size(const Vec &var, Mesh1d &ex, double t, bool &stop_flag,
+                     double tend) const {
+        double dt = derived().get_dt(var, ex, t);
+        if (t + dt >= tend && t < tend) {
+            dt = tend - t;
+            stop_flag = true;
+        }
+        return dt;
+    }
+
+    // L at time t on flat vectors
+    auto op(Mesh1d &ex, double t) const {
+        return [this, &ex, t](const Vector &v) {
+            return derived().op_L(Vec{v}, ex, t).data;
+        };
+    }
+
+    static auto fail(const char *what, double t)
+        -> flux::expected<Vec, std::string> {
+        return flux::unexpected{std::string{what} + " did not converge at t = "
+                                + std::to_string(t) + ", reduce dt"};
+    }
+
+private:
+    auto updater(Mesh1d &ex, double tend, ImplicitStats &stats) const {
+        return [this, &ex, tend, &stats](const Vec &v, double &t,
+                                         bool &stop_flag) {
+            return derived().update(v, ex, t, stop_flag, tend, stats);
+        };
+    }
+};
+
+template <DIRKTableau Tableau, typename Derived>
+class DIRKSolver : public ImplicitSolverBase<Derived> {
+    using Base = ImplicitSolverBase<Derived>;
+    using Base::derived;
+
+public:
+    auto update(const Vec &var, Mesh1d &ex, double &t, bool &stop_flag,
+                double tend, ImplicitStats &stats) const
+        -> flux::expected<Vec, std::string> {
+        constexpr size_t s = Tableau::stages;
+        double dt = this->step_size(var, ex, t, stop_flag, tend);
+        auto cfg = derived().newton_krylov_config(ex);
+
+        auto var_n = derived().pre_process(var, ex, t);
+        const auto &u = var_n.data;
+
+        const double alpha = dt * Tableau::gamma;
+        auto M = implicit::BlockJacobi{};
+        if (cfg.block > 0) {
+            auto L = this->op(ex, t);
+            M = implicit::BlockJacobi(L, u, L(u), alpha, cfg.block,
+                                      cfg.coupling);
+        }
+
+        // K[i] = L(U_i), recovered from the stage equation
+        std::array<Vector, s> K;
+        Vector U = u;
+        for (size_t i = 0; i < s; i++) {
+            auto rhs = u;
+            for (size_t j = 0; j < i; j++) {
+                implicit::axpy(dt * Tableau::a[i][j], K[j], rhs);
+            }
+
+            auto res = implicit::newton(this->op(ex, t + Tableau::c[i] * dt),
+                                        alpha, rhs, U, M, cfg);
+            stats.newton_iterations += res.iterations;
+            stats.krylov_iterations += res.krylov_iterations;
+            if (!res.converged) return this->fail("DIRKSolver: Newton", t);
+
+            K[i] = Vector(u.size());
+            for (size_t q = 0; q < u.size(); q++) {
+                K[i][q] = (U[q] - rhs[q]) / alpha;
+            }
+        }
+
+        auto result = u;
+        for (size_t i = 0; i < s; i++) {
+            implicit::axpy(dt * Tableau::b[i], K[i], result);
+        }
+        stats.steps++;
+
+        auto var2 = derived().post_process(Vec{result}, ex, t + dt);
+        t += dt;
+        return var2;
+    }
+};
+
+// ROS2, gamma = 1 + 1/sqrt(2), with J = dL/du at u_n:
+//   (I - gamma dt J) k1 = dt L(u_n)
+//   (I - gamma dt J) k2 = dt L(u_n + k1) - 2 k1
+//   u_{n+1} = u_n + 3/2 k1 + 1/2 k2
+// The linear solves are its only error control, so krylov_rtol should be
+// well below the local error.
+template <typename Derived>
+class RosenbrockSolver : public ImplicitSolverBase<Derived> {
+    using Base = ImplicitSolverBase<Derived>;
+    using Base::derived;
+
+public:
+    static constexpr double gamma = 1.7071067811865475;
+
+    auto update(const Vec &var, Mesh1d &ex, double &t, bool &stop_flag,
+                double tend, ImplicitStats &stats) const
+        -> flux::expected<Vec, std::string> {
+        double dt = this->step_size(var, ex, t, stop_flag, tend);
+        auto cfg = derived().newton_krylov_config(ex);
+
+        auto var_n = derived().pre_process(var, ex, t);
+        const auto &u = var_n.data;
+
+        const double alpha = gamma * dt;
+        auto L = this->op(ex, t);
+        auto Lu = L(u);
+        auto M = implicit::BlockJacobi{};
+        if (cfg.block > 0) {
+            M = implicit::BlockJacobi(L, u, Lu, alpha, cfg.block,
+                                      cfg.coupling);
+        }
+
+        auto A = [&](const Vector &v) {
+            auto Jv = implicit::jacobian_vector(L, u, Lu, v);
+            for (size_t i = 0; i < v.size(); i++) Jv[i] = v[i] - alpha * Jv[i];
+            return Jv;
+        };
+        bool converged = true;
+        auto solve = [&](const Vector &b) {
+            auto k = Vector(b.size());
+            auto res = implicit::gmres(A, M, b, k, cfg);
+            stats.krylov_iterations += res.iterations;
+            converged = converged && res.converged;
+            return k;
+        };
+
+        auto b1 = Lu;
+        for (auto &v : b1) v *= dt;
+        auto k1 = solve(b1);
+        if (!converged) return this->fail("RosenbrockSolver: GMRES", t);
+
+        auto u1 = u;
+        implicit::axpy(1, k1, u1);
+        auto b2 = this->op(ex, t + dt)(u1);
+        for (size_t i = 0; i < b2.size(); i++) b2[i] = dt * b2[i] - 2 * k1[i];
+        auto k2 = solve(b2);
+        if (!converged) return this->fail("RosenbrockSolver: GMRES", t);
+
+        auto result = u;
+        implicit::axpy(1.5, k1, result);
+        implicit::axpy(0.5, k2, result);
+        stats.steps++;
+
+        auto var2 = derived().post_process(Vec{result}, ex, t + dt);
+        t += dt;
+        return var2;
+    }
+};
+
+}  // namespace flux::solver_implicit
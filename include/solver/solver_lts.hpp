@@ -0,0 +1,324 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "amr/grid.hpp"
+#include "expected.hpp"
+#include "preset.hpp"
+#include "runge_kutta.hpp"
+#include "subdomain_scheme.hpp"
+
+namespace flux::solver_lts {
+
+// Local time stepping on an amr::Grid: the blocks of level l advance with
+// dt_l = 2^{L - l} dt_L, L the finest level and dt_L the scheme's dt at its
+// cell width, so a block takes as many steps as its own cells need instead
+// of as many as the finest cells need. The levels are subcycled recursively
+// (Berger and Oliger): one step of level l, then two of level l + 1.
+//
+// Ghost cells of level l come from coarser blocks interpolated linearly in
+// time between the start and the end of their step, and from finer blocks
+// extrapolated with their L at the start of the coarse step. Every face
+// between levels accumulates the time integral of its flux on both sides;
+// after the fine steps the coarse cell trades its own for the fine one
+// (refluxing), so the scheme stays conservative. The grid is adapted when
+// the finest level has taken `interval` steps, at the next time all levels
+// meet. Every level takes the stages of the tableau Tableau
+// (runge_kutta.hpp), a face flux enters its integral with the weight of its
+// stage (rk::weights).
+template <ConservativeScheme Scheme, rk::RKTableau Tableau>
+class Solver {
+    static_assert(!Scheme::stage_speed,
+                  "solver_lts: the levels are not in step, op_L must not "
+                  "need a global speed");
+
+public:
+    static constexpr size_t halo = Scheme::halo;  // of the grid
+
+    explicit Solver(Scheme scheme, amr::RegridConfig regrid = {})
+        : m_scheme(std::move(scheme)), m_regrid(regrid) {}
+
+    const amr::RegridConfig &regrid() const { return m_regrid; }
+
+    // one regrid pass, e.g. to refine the initial data
+    void adapt(amr::Grid &grid) const { grid.adapt(m_regrid); }
+
+    auto run(amr::Grid grid, double t0,
+             double tend) const -> flux::expected<amr::Grid, std::string> {
+        size_t cell_updates = 0;
+        return run(std::move(grid), t0, tend, cell_updates);
+    }
+
+    // cell_updates: the cell steps of the run, each cell counted once per
+    // step of its level
+    auto run(amr::Grid grid, double t0, double tend, size_t &cell_updates) const
+        -> flux::expected<amr::Grid, std::string> {
+        cell_updates = 0;
+        if (grid.halo() != Scheme::halo) {
+            return flux::unexpected{
+                std::string{"solver_lts: grid halo does not match the scheme"}};
+        }
+        if (tend <= t0) return grid;
+
+        if (!time_loop(grid, t0, tend, cell_updates)) {
+            return flux::unexpected{std::string{"Iteration exceeds"}};
+        }
+        return grid;
+    }
+
+private:
+    using Stages = rk::InPlaceStages<Tableau>;
+
+    // the state of one step of the coarsest level, for fixed blocks
+    class Cycle {
+        static constexpr auto c = rk::stage_times<Tableau>();
+        static constexpr auto weight = rk::weights<Tableau>();
+
+    public:
+        Cycle(const Scheme &scheme, amr::Grid &grid, double df_max,
+              size_t coarsest, double dt, size_t &cell_updates)
+            : m_scheme(scheme), m_grid(grid), m_blocks(grid.blocks()),
+              m_n(grid.block()), m_df_max(df_max), m_coarsest(coarsest),
+              m_dt(dt), m_cell_updates(cell_updates),
+              m_stages(m_blocks.size(), Stages(m_n, true)),
+              m_rate(m_blocks.size()), m_saved(m_blocks.size()),
+              m_start(grid.finest_level() + 1),
+              m_flux_coarse(m_blocks.size()), m_flux_fine(m_blocks.size()) {}
+
+        void step(size_t level, double t) {
+            const double dt = level_dt(level);
+            const bool finer = level < m_grid.finest_level();
+            if (finer) {
+                for (size_t f = 0; f < m_blocks.size(); f++) {
+                    if (interface_of(f, level)) {
+                        m_flux_coarse[f] = 0;
+                        m_flux_fine[f] = 0;
+                    }
+                }
+                rates(level + 1, t);
+            }
+
+            m_start[level] = t;
+            for (const auto &b : m_blocks) {
+                if (b.level == level) m_cell_updates += m_n;
+            }
+            rk::for_each_stage<Tableau>([&](auto s) {
+                this->template stage<decltype(s)::value>(level, t, dt);
+            });
+
+            if (finer) {
+                step(level + 1, t);
+                step(level + 1, t + dt / 2);
+                reflux(level);
+                for (size_t k = 0; k < m_blocks.size(); k++) {
+                    if (m_blocks[k].level == level + 1) m_rate[k].clear();
+                }
+            }
+        }
+
+    private:
+        double level_dt(size_t level) const {
+            return std::ldexp(m_dt, -static_cast<int>(level - m_coarsest));
+        }
+
+        size_t right(size_t k) const { return (k + 1) % m_blocks.size(); }
+
+        size_t left(size_t k) const {
+            return (k + m_blocks.size() - 1) % m_blocks.size();
+        }
+
+        // face f between blocks f and f + 1 joins level and level + 1
+        bool interface_of(size_t f, size_t level) const {
+            size_t a = m_blocks[f].level;
+            size_t b = m_blocks[right(f)].level;
+            return std::min(a, b) == level && std::max(a, b) == level + 1;
+        }
+
+        bool near(size_t k, size_t level) const {
+            const size_t nb = m_blocks.size();
+            for (size_t d = 1; d <= 2; d++) {
+                if (m_blocks[(k + d) % nb].level == level
+                    || m_blocks[(k + nb * d - d) % nb].level == level) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // fills the ghost cells of `level` from the other levels at time
+        // tau: the blocks around it are set to their state at tau for the
+        // fill and restored afterwards
+        void fill_ghosts(size_t level, double tau) {
+            std::vector<size_t> views;
+            for (size_t k = 0; k < m_blocks.size(); k++) {
+                auto &b = m_blocks[k];
+                if (b.level == level || !near(k, level)) continue;
+                if (b.level > level && m_rate[k].empty()) continue;
+
+                double *w = b.u.data() + halo;
+                m_saved[k].assign(w, w + m_n);
+                if (b.level < level) {
+                    const auto &u_n = m_stages[k].start();
+                    double theta = (tau - m_start[b.level]) / level_dt(b.level);
+                    for (size_t i = 0; i < m_n; i++) {
+                        w[i] = (1 - theta) * u_n[i] + theta * w[i];
+                    }
+                }
+                else {
+                    double h = tau - m_start[level];
+                    for (size_t i = 0; i < m_n; i++) w[i] += h * m_rate[k][i];
+                }
+                views.push_back(k);
+            }
+
+            m_grid.fill_ghosts(level);
+            for (size_t k : views) {
+                std::copy(m_saved[k].begin(), m_saved[k].end(),
+                          m_blocks[k].u.begin() + halo);
+            }
+        }
+
+        // L at time t of the blocks of `level` next to the coarser level,
+        // which extrapolates them while they wait for their steps
+        void rates(size_t level, double t) {
+            m_start[level] = t;
+            m_grid.fill_ghosts(level);
+            for (size_t k = 0; k < m_blocks.size(); k++) {
+                const auto &b = m_blocks[k];
+                if (b.level != level) continue;
+                if (m_blocks[left(k)].level >= level
+                    && m_blocks[right(k)].level >= level) {
+                    continue;
+                }
+                m_rate[k].resize(m_n);
+                m_scheme.op_L(b.u, m_df_max, Mesh1d{m_grid.dx(level)},
+                              m_rate[k], 0, m_n);
+            }
+        }
+
+        template <size_t I>
+        void stage(size_t level, double t, double dt) {
+            fill_ghosts(level, t + c[I - 1] * dt);
+
+            const double h = dt * weight[I - 1];
+            for (size_t k = 0; k < m_blocks.size(); k++) {
+                auto &b = m_blocks[k];
+                if (b.level != level) continue;
+                m_scheme.op_L(b.u, m_df_max, Mesh1d{m_grid.dx(level)},
+                              m_stages[k].rate(I), 0, m_n);
+
+                // faces to other levels, before the update changes b.u
+                size_t l = left(k);
+                if (m_blocks[l].level != level) {
+                    accumulate(l, m_blocks[l].level > level,
+                               h * m_scheme.face_flux(b.u, m_df_max, 0));
+                }
+                if (m_blocks[right(k)].level != level) {
+                    accumulate(k, m_blocks[right(k)].level > level,
+                               h * m_scheme.face_flux(b.u, m_df_max, m_n));
+                }
+
+                m_stages[k].template update<I>(b.u.data() + halo, dt);
+            }
+        }
+
+        void accumulate(size_t f, bool coarse, double flux) {
+            (coarse ? m_flux_coarse : m_flux_fine)[f] += flux;
+        }
+
+        // the coarse cells at faces between level and level + 1 replace the
+        // integral of their flux by the one of the fine block
+        void reflux(size_t level) {
+            const double dx = m_grid.dx(level);
+            for (size_t f = 0; f < m_blocks.size(); f++) {
+                if (!interface_of(f, level)) continue;
+                double jump = (m_flux_coarse[f] - m_flux_fine[f]) / dx;
+                if (m_blocks[f].level == level) {
+                    m_blocks[f].u[halo + m_n - 1] += jump;
+                }
+                else {
+                    m_blocks[right(f)].u[halo] -= jump;
+                }
+            }
+        }
+
+        const Scheme &m_scheme;
+        amr::Grid &m_grid;
+        std::vector<amr::Block> &m_blocks;
+        size_t m_n;
+        double m_df_max;
+        size_t m_coarsest;
+        double m_dt;  // of the coarsest level
+        size_t &m_cell_updates;
+
+        std::vector<Stages> m_stages;              // u_n: at its step start
+        std::vector<std::vector<double>> m_rate;   // empty: not extrapolated
+        std::vector<std::vector<double>> m_saved;  // owned cells under a view
+        std::vector<double> m_start;               // step start of each level
+        std::vector<double> m_flux_coarse;         // per face f, f + 1
+        std::vector<double> m_flux_fine;
+    };
+
+    bool time_loop(amr::Grid &grid, double t, double tend,
+                   size_t &cell_updates) const {
+        const size_t n = grid.block();
+        const auto &blocks = grid.blocks();
+
+        auto speed = [&]() {
+            double df_max = 0;
+            for (const auto &b : blocks) {
+                auto ex = Mesh1d{grid.dx(b.level)};
+                df_max = std::max(df_max,
+                                  m_scheme.max_speed(b.u, ex, halo, halo + n));
+            }
+            return df_max;
+        };
+
+        bool stop_flag = false;
+        size_t fine_steps = 0;  // of the finest level since the last regrid
+        constexpr auto iter_max = std::numeric_limits<size_t>::max();
+        for (size_t iter = 0; iter < iter_max && (!stop_flag); ++iter) {
+            if (m_regrid.interval > 0 && fine_steps >= m_regrid.interval) {
+                grid.adapt(m_regrid);
+                fine_steps = 0;
+            }
+
+            size_t coarsest = grid.max_level();
+            for (const auto &b : blocks) coarsest = std::min(coarsest, b.level);
+            const size_t finest = grid.finest_level();
+            const int ratio = static_cast<int>(finest - coarsest);
+
+            double df_max = speed();
+            auto mesh = Mesh1d{grid.dx(finest)};
+            double dt =
+                std::ldexp(Tableau::ssp * m_scheme.dt(df_max, mesh), ratio);
+            if (t + dt >= tend && t < tend) {
+                dt = tend - t;
+                stop_flag = true;
+            }
+
+            Cycle(m_scheme, grid, df_max, coarsest, dt, cell_updates)
+                .step(coarsest, t);
+            fine_steps += size_t{1} << ratio;
+            t += dt;
+        }
+        return stop_flag;
+    }
+
+    Scheme m_scheme;
+    amr::RegridConfig m_regrid;
+};
+
+template <ConservativeScheme Scheme>
+using EulerSolver = Solver<Scheme, rk::ForwardEuler>;
+
+template <ConservativeScheme Scheme>
+using RK3Solver = Solver<Scheme, rk::SSPRK3>;
+
+}  // namespace flux::solver_lts
@@ -0,0 +1,244 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <mpi.h>
+
+#include "expected.hpp"
+#include "parallel/partition.hpp"
+#include "preset.hpp"
+#include "runge_kutta.hpp"
+#include "subdomain_scheme.hpp"
+
+namespace flux::solver_mpi {
+
+// MPI_Init/MPI_Finalize
+class Environment {
+public:
+    Environment(int &argc, char **&argv) {
+        MPI_Init(&argc, &argv);
+        MPI_Comm_rank(MPI_COMM_WORLD, &m_rank);
+        MPI_Comm_size(MPI_COMM_WORLD, &m_size);
+    }
+
+    Environment(const Environment &) = delete;
+
+    Environment &operator=(const Environment &) = delete;
+
+    ~Environment() { MPI_Finalize(); }
+
+    int rank() const { return m_rank; }
+
+    int size() const { return m_size; }
+
+    // output file `name` on rank 0, discarded on the other ranks
+    const char *root_only(const char *name) const {
+        return m_rank == 0 ? name : "/dev/null";
+    }
+
+private:
+    int m_rank{0};
+    int m_size{1};
+};
+
+// Time integration of a periodic grid split across the ranks of `comm`
+// (2d meshes in slabs of rows). Each rank stores only its slice padded with
+// ghost cells, which are exchanged with the neighbouring ranks before every
+// op_L: the interior cells are computed while the messages are in flight,
+// the cells next to the ghost cells after they arrive. dt is an
+// MPI_Allreduce of the local speeds, so the result is bitwise identical to
+// the serial frameworks for any number of ranks. The stages are those of the
+// tableau Tableau (runge_kutta.hpp).
+template <SubdomainScheme Scheme, rk::RKTableau Tableau>
+class Solver {
+public:
+    using ExType = typename Scheme::mesh_type;
+
+    // run is collective, a cache hit on some ranks only would deadlock
+    static constexpr bool cache_results = false;
+
+    explicit Solver(Scheme scheme, MPI_Comm comm = MPI_COMM_WORLD)
+        : m_scheme(std::move(scheme)), m_comm(comm) {
+        MPI_Comm_rank(m_comm, &m_rank);
+        MPI_Comm_size(m_comm, &m_size);
+    }
+
+    // split of `cells` cells (rows of a 2d mesh) over the ranks
+    parallel::Partition partition(std::size_t cells) const {
+        return {cells, Scheme::halo, static_cast<std::size_t>(m_size)};
+    }
+
+    // distributed state: `local` holds the cells partition(cells).range(rank)
+    // of this rank, the result the same cells at tend
+    auto run_local(std::vector<double> local, ExType &ex, double t0,
+                   double tend) const
+        -> flux::expected<std::vector<double>, std::string> {
+        const std::size_t block = m_scheme.block(ex);
+        const std::size_t n = local.size() / block;
+
+        auto cells = static_cast<std::uint64_t>(n);
+        MPI_Allreduce(MPI_IN_PLACE, &cells, 1, MPI_UINT64_T, MPI_SUM, m_comm);
+        auto part = partition(static_cast<std::size_t>(cells));
+        auto [begin, end] = part.range(static_cast<std::size_t>(m_rank));
+        const std::size_t min_cells = std::max<std::size_t>(Scheme::halo, 1);
+        if (n != end - begin || part.cells < min_cells) {
+            return flux::unexpected{
+                std::string{"solver_mpi: local state does not match the "
+                            "partition"}};
+        }
+
+        if (tend <= t0) return local;
+
+        const auto owned = static_cast<std::ptrdiff_t>(Scheme::halo * block);
+        auto u = std::vector<double>((n + 2 * Scheme::halo) * block);
+        std::copy(local.begin(), local.end(), u.begin() + owned);
+
+        if (!time_loop(u, part, ex, t0, tend)) {
+            return flux::unexpected{std::string{"Iteration exceeds"}};
+        }
+
+        std::copy_n(u.begin() + owned, n * block, local.begin());
+        return local;
+    }
+
+    // every rank passes the whole state and receives the whole result;
+    // for states beyond the memory of one rank use run_local
+    auto run(Vec var, ExType &ex, double t0,
+             double tend) const -> flux::expected<Vec, std::string> {
+        const std::size_t block = m_scheme.block(ex);
+        auto part = partition(var.data.size() / block);
+
+        auto [begin, end] = part.range(static_cast<std::size_t>(m_rank));
+        auto slice = [&](std::size_t i) {
+            return var.data.begin() + static_cast<std::ptrdiff_t>(i * block);
+        };
+        auto result = run_local(std::vector<double>(slice(begin), slice(end)),
+                                ex, t0, tend);
+        if (!result) return flux::unexpected{result.error()};
+
+        auto counts = std::vector<int>(static_cast<std::size_t>(m_size));
+        auto displs = std::vector<int>(static_cast<std::size_t>(m_size));
+        for (std::size_t r = 0; r < counts.size(); r++) {
+            auto [b, e] = part.range(r);
+            counts[r] = static_cast<int>((e - b) * block);
+            displs[r] = static_cast<int>(b * block);
+        }
+        const int count = counts[static_cast<std::size_t>(m_rank)];
+        MPI_Allgatherv(result.value().data(), count, MPI_DOUBLE,
+                       var.data.data(), counts.data(), displs.data(),
+                       MPI_DOUBLE, m_comm);
+        return var;
+    }
+
+private:
+    // post the ghost cell messages of the padded state u
+    void start_exchange(std::vector<double> &u,
+                        const parallel::Partition &part, std::size_t block,
+                        std::array<MPI_Request, 4> &requests) const {
+        const auto p = static_cast<std::size_t>(m_rank);
+        const auto left = static_cast<int>(part.left(p));
+        const auto right = static_cast<int>(part.right(p));
+        const auto width = static_cast<int>(Scheme::halo * block);
+        const std::size_t n = u.size() - 2 * Scheme::halo * block;
+        double *data = u.data();
+
+        // tag 0: data going right, tag 1: data going left
+        MPI_Irecv(data, width, MPI_DOUBLE, left, 0, m_comm, &requests[0]);
+        MPI_Irecv(data + Scheme::halo * block + n, width, MPI_DOUBLE, right, 1,
+                  m_comm, &requests[1]);
+        MPI_Isend(data + Scheme::halo * block, width, MPI_DOUBLE, left, 1,
+                  m_comm, &requests[2]);
+        MPI_Isend(data + n, width, MPI_DOUBLE, right, 0, m_comm, &requests[3]);
+    }
+
+    bool time_loop(std::vector<double> &u, const parallel::Partition &part,
+                   const ExType &ex, double t, double tend) const {
+        const std::size_t block = m_scheme.block(ex);
+        const std::size_t halo = Scheme::halo;
+        const std::size_t n = u.size() / block - 2 * halo;
+        const std::size_t len = n * block;
+        const bool active = static_cast<std::size_t>(m_rank) < part.parts;
+        double *w = u.data() + halo * block;
+
+        // cells [a, b) read no ghost cells
+        const std::size_t a = std::min(halo, n);
+        const std::size_t b = std::max(a, n - std::min(halo, n));
+
+        using Stages = rk::InPlaceStages<Tableau>;
+        auto stages = Stages(len);
+        auto limited = std::vector<double>(len);
+        std::array<MPI_Request, 4> requests{};
+
+        auto speed = [&]() {
+            double df_max =
+                active ? m_scheme.max_speed(u, ex, halo, halo + n) : 0.0;
+            MPI_Allreduce(MPI_IN_PLACE, &df_max, 1, MPI_DOUBLE, MPI_MAX,
+                          m_comm);
+            return df_max;
+        };
+
+        auto apply_op_L = [&](double df_max, std::vector<double> &L) {
+            if (!active) return;
+
+            start_exchange(u, part, block, requests);
+            m_scheme.op_L(u, df_max, ex, L, a, b);  // overlaps the messages
+            MPI_Waitall(4, requests.data(), MPI_STATUSES_IGNORE);
+            m_scheme.op_L(u, df_max, ex, L, 0, a);
+            m_scheme.op_L(u, df_max, ex, L, b, n);
+        };
+
+        auto stage_limiter = [&]() {
+            if constexpr (SubdomainStageLimiter<Scheme>) {
+                if (!active || !m_scheme.stage_limiter()) return;
+
+                start_exchange(u, part, block, requests);
+                MPI_Waitall(4, requests.data(), MPI_STATUSES_IGNORE);
+                m_scheme.post_process_rk_stage(u, ex, limited, 0, n);
+                std::copy_n(limited.begin(), len, w);
+            }
+        };
+
+        bool stop_flag = false;
+        constexpr auto iter_max = std::numeric_limits<std::size_t>::max();
+        for (std::size_t iter = 0; iter < iter_max && (!stop_flag); ++iter) {
+            double df_max = speed();
+            double dt = Tableau::ssp * m_scheme.dt(df_max, ex);
+            if (t + dt >= tend && t < tend) {
+                dt = tend - t;
+                stop_flag = true;
+            }
+
+            rk::for_each_stage<Tableau>([&](auto stage) {
+                constexpr std::size_t i = decltype(stage)::value;
+                if constexpr (Stages::uses_rate(i)) {
+                    bool fresh = i > 1 && Scheme::stage_speed;  // speed of w
+                    apply_op_L(fresh ? speed() : df_max, stages.rate(i));
+                }
+                stages.template update<i>(w, dt, stage_limiter);
+            });
+
+            t += dt;
+        }
+        return stop_flag;
+    }
+
+    Scheme m_scheme;
+    MPI_Comm m_comm;
+    int m_rank{0};
+    int m_size{1};
+};
+
+template <SubdomainScheme Scheme>
+using EulerSolver = Solver<Scheme, rk::ForwardEuler>;
+
+template <SubdomainScheme Scheme>
+using RK3Solver = Solver<Scheme, rk::SSPRK3>;
+
+}  // namespace flux::solver_mpi
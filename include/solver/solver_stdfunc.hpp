@@ -3,9 +3,13 @@
 #include <functional>
 #include <limits>
 #include <string>
+#include <utility>
 
+#include "checkpoint.hpp"
 #include "expected.hpp"
+#include "profiler.hpp"
 #include "requires.h"
+#include "runge_kutta.hpp"
 
 namespace flux::solver_stdfunc {
 
@@ -26,9 +30,11 @@ public:
             return flux::unexpected{std::string{"update function is not set"}};
         }
 
+        FLUX_PROFILE_RUN();
+
         if (tend <= t0) return var;
 
-        double t = 0;
+        double t = t0;
         bool stop_flag = false;
         constexpr auto iter_max = std::numeric_limits<std::size_t>::max();
         for (size_t iter = 0; iter < iter_max && (!stop_flag); ++iter) {
@@ -39,6 +45,40 @@ public:
         return var;
     }
 
+    // run with periodic checkpoints, see checkpoint.hpp
+    auto run(VarType var, ExType &ex, double t0, double tend,
+             const CheckpointConfig &cfg) const
+        -> flux::expected<VarType, std::string> {
+        if (m_update == nullptr) {
+            return flux::unexpected{std::string{"update function is not set"}};
+        }
+
+        return run_with_checkpoint(
+            std::move(var), t0, 0, tend, cfg,
+            [&](const VarType &v, double &t, bool &stop_flag) {
+                return m_update(v, ex, t, stop_flag, tend);
+            });
+    }
+
+    // resume from cfg.path, keep writing checkpoints to it
+    auto run_from_checkpoint(ExType &ex, double tend,
+                             const CheckpointConfig &cfg) const
+        -> flux::expected<VarType, std::string> {
+        if (m_update == nullptr) {
+            return flux::unexpected{std::string{"update function is not set"}};
+        }
+
+        auto ckpt = load_checkpoint<VarType>(cfg.path);
+        if (!ckpt) { return flux::unexpected{ckpt.error()}; }
+
+        auto &state = ckpt.value();
+        return run_with_checkpoint(
+            std::move(state.var), state.t, state.iter, tend, cfg,
+            [&](const VarType &v, double &t, bool &stop_flag) {
+                return m_update(v, ex, t, stop_flag, tend);
+            });
+    }
+
 protected:
     UpdateFunc m_update;
 };
@@ -61,23 +101,35 @@ public:
 
         return [=](const VarType &var, ExType &ex, double &t, bool &stop_flag,
                    double tend) {
-            double dt = get_dt(var, ex, t);
+            double dt = FLUX_PROFILE_CALL(get_dt, profile::bytes_of(var),
+                                          get_dt(var, ex, t));
             if (t + dt >= tend && t < tend) {
                 dt = tend - t;
                 stop_flag = true;
             }
-            auto var_n = pre_process(var, ex, t);
 
-            VarType var2 = var_n + dt * op_L(var_n, ex, t);
+            auto var_n = FLUX_PROFILE_CALL(
+                pre_process, 2 * profile::bytes_of(var),
+                pre_process(var, ex, t));
 
-            var2 = post_process(var2, ex, t);
+            VarType L0 = FLUX_PROFILE_CALL(op_L, 2 * profile::bytes_of(var_n),
+                                           op_L(var_n, ex, t));
+            VarType var2 = FLUX_PROFILE_CALL(
+                rk_combine, 3 * profile::bytes_of(var_n),
+                var_n + dt * L0);
+
+            var2 = FLUX_PROFILE_CALL(post_process, 2 * profile::bytes_of(var2),
+                                     post_process(var2, ex, t));
 
             t += dt;
             return var2;
         };
     }
 
-    static auto get_rk3_updater(
+    // explicit Runge-Kutta with the Shu-Osher tableau Tableau of
+    // runge_kutta.hpp, dt is Tableau::ssp times get_dt
+    template <rk::RKTableau Tableau>
+    static auto get_rk_updater(
         OpFunc op_L, DtFunc get_dt, OpFunc pre_process, OpFunc post_process,
         OpFunc post_process_rk_stage) -> Solver<VarType, ExType>::UpdateFunc {
         auto no_op = [](const VarType &var, ExType &ex, double t) {
@@ -90,34 +142,38 @@ public:
 
         return [=](const VarType &var, ExType &ex, double &t, bool &stop_flag,
                    double tend) {
-            double dt = get_dt(var, ex, t);
+            double dt = Tableau::ssp
+                        * FLUX_PROFILE_CALL(get_dt, profile::bytes_of(var),
+                                            get_dt(var, ex, t));
             if (t + dt >= tend && t < tend) {
                 dt = tend - t;
                 stop_flag = true;
             }
 
-            auto var_n = pre_process(var, ex, t);
-
-            VarType var1 = var_n + dt * op_L(var_n, ex, t);
-
-            var1 = post_process_rk_stage(var1, ex, t);
-
-            VarType var2 = (3.0 / 4) * var_n
-                           + (1.0 / 4) * (var1 + dt * op_L(var1, ex, t + dt));
-
-            var2 = post_process_rk_stage(var2, ex, t + dt);
-
-            VarType var3 =
-                (1.0 / 3) * var_n
-                + (2.0 / 3) * (var2 + dt * op_L(var2, ex, t + dt / 2));
+            auto var_n = FLUX_PROFILE_CALL(
+                pre_process, 2 * profile::bytes_of(var),
+                pre_process(var, ex, t));
 
-            var3 = post_process_rk_stage(var3, ex, t + dt / 2);
+            VarType var2 = rk::step<Tableau>(
+                var_n, t, dt,
+                [&](const VarType &v, double tau) { return op_L(v, ex, tau); },
+                [&](const VarType &v, double tau) {
+                    return post_process_rk_stage(v, ex, tau);
+                });
 
-            var3 = post_process(var3, ex, t + dt);
+            var2 = FLUX_PROFILE_CALL(post_process, 2 * profile::bytes_of(var2),
+                                     post_process(var2, ex, t + dt));
 
             t += dt;
-            return var3;
+            return var2;
         };
     }
+
+    static auto get_rk3_updater(
+        OpFunc op_L, DtFunc get_dt, OpFunc pre_process, OpFunc post_process,
+        OpFunc post_process_rk_stage) -> Solver<VarType, ExType>::UpdateFunc {
+        return get_rk_updater<rk::SSPRK3>(op_L, get_dt, pre_process,
+                                          post_process, post_process_rk_stage);
+    }
 };
 }  // namespace flux::solver_stdfunc
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "expected.hpp"
+#include "parallel/domain.hpp"
+#include "parallel/thread_team.hpp"
+#include "preset.hpp"
+#include "runge_kutta.hpp"
+#include "subdomain_scheme.hpp"
+
+namespace flux::solver_threads {
+
+// Time integration of a periodic grid split into one subdomain per thread of
+// a pinned ThreadTeam (2d meshes in slabs of rows). Each thread allocates
+// (first touches) its slice and scratch arrays and runs the whole time loop
+// on them. Ghost cells are exchanged before every op_L and stage limiter, dt
+// is a max-reduction of the local speeds, so the result is bitwise identical
+// to the serial frameworks. The stages are those of the tableau Tableau
+// (runge_kutta.hpp).
+template <SubdomainScheme Scheme, rk::RKTableau Tableau>
+class Solver {
+public:
+    using ExType = typename Scheme::mesh_type;
+
+    explicit Solver(Scheme scheme,
+                    std::size_t threads = parallel::default_thread_count(),
+                    bool pin = true)
+        : m_scheme(std::move(scheme)),
+          m_team(std::make_shared<parallel::ThreadTeam>(threads, pin)) {}
+
+    std::size_t threads() const { return m_team->size(); }
+
+    auto run(Vec var, ExType &ex, double t0,
+             double tend) const -> flux::expected<Vec, std::string> {
+        if (tend <= t0) return var;
+
+        const std::size_t block = m_scheme.block(ex);
+        auto domain = parallel::DecomposedDomain(
+            *m_team, var.data.size() / block, Scheme::halo, block);
+        if (!domain.valid()) {
+            return flux::unexpected{
+                std::string{"solver_threads: fewer cells than the halo"}};
+        }
+
+        bool stop_flag = false;
+        m_team->run([&](std::size_t tid) {
+            auto &sub = domain.allocate(tid);
+            auto slice = var.data.begin()
+                         + static_cast<std::ptrdiff_t>(sub.begin() * block);
+            std::copy_n(slice, sub.size() * block, sub.owned());
+
+            bool stop = time_loop(domain, tid, ex, t0, tend);
+            if (tid == 0) stop_flag = stop;  // the same on every thread
+
+            std::copy_n(sub.owned(), sub.size() * block, slice);
+        });
+
+        if (!stop_flag) {
+            return flux::unexpected{std::string{"Iteration exceeds"}};
+        }
+        return var;
+    }
+
+private:
+    bool time_loop(parallel::DecomposedDomain &domain, std::size_t tid,
+                   const ExType &ex, double t, double tend) const {
+        auto &team = *m_team;
+        auto &sub = domain[tid];
+        const auto &u = sub.data();
+        double *w = sub.owned();
+        const std::size_t len = sub.size() * sub.block();
+        const bool active = sub.size() > 0;
+
+        // scratch, first touched by this thread
+        using Stages = rk::InPlaceStages<Tableau>;
+        auto stages = Stages(len);
+        auto limited = std::vector<double>(len);
+
+        auto speed = [&]() {
+            double local = active ? m_scheme.max_speed(u, ex, sub.halo(),
+                                                       sub.halo() + sub.size())
+                                  : 0.0;
+            return team.reduce_max(tid, local);
+        };
+
+        auto apply_op_L = [&](double df_max, std::vector<double> &L) {
+            domain.exchange(tid);
+            if (active) m_scheme.op_L(u, df_max, ex, L, 0, sub.size());
+        };
+
+        auto stage_limiter = [&]() {
+            if constexpr (SubdomainStageLimiter<Scheme>) {
+                if (!m_scheme.stage_limiter()) return;
+
+                domain.exchange(tid);
+                if (active) {
+                    m_scheme.post_process_rk_stage(u, ex, limited, 0,
+                                                   sub.size());
+                    std::copy_n(limited.begin(), len, w);
+                }
+            }
+        };
+
+        bool stop_flag = false;
+        constexpr auto iter_max = std::numeric_limits<std::size_t>::max();
+        for (std::size_t iter = 0; iter < iter_max && (!stop_flag); ++iter) {
+            double df_max = speed();
+            double dt = Tableau::ssp * m_scheme.dt(df_max, ex);
+            if (t + dt >= tend && t < tend) {
+                dt = tend - t;
+                stop_flag = true;
+            }
+
+            rk::for_each_stage<Tableau>([&](auto stage) {
+                constexpr std::size_t i = decltype(stage)::value;
+                if constexpr (Stages::uses_rate(i)) {
+                    bool fresh = i > 1 && Scheme::stage_speed;  // speed of w
+                    apply_op_L(fresh ? speed() : df_max, stages.rate(i));
+                }
+                stages.template update<i>(w, dt, stage_limiter);
+            });
+
+            t += dt;
+        }
+        return stop_flag;
+    }
+
+    Scheme m_scheme;
+    std::shared_ptr<parallel::ThreadTeam> m_team;  // shared by copies
+};
+
+template <SubdomainScheme Scheme>
+using EulerSolver = Solver<Scheme, rk::ForwardEuler>;
+
+template <SubdomainScheme Scheme>
+using RK3Solver = Solver<Scheme, rk::SSPRK3>;
+
+}  // namespace flux::solver_threads
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <vector>
+
+#include "preset.hpp"
+
+namespace flux {
+
+// Kernels of a scheme on one subdomain of a periodic grid split along its
+// last dimension, as used by solver_threads.hpp and solver_mpi.hpp.
+//
+// `u` is the subdomain state padded with Scheme::halo ghost cells on each
+// side, every cell holding block(ex) doubles (a row of a 2d mesh is one
+// cell). max_speed and op_L take ranges of owned cells, op_L writes
+// L[first * block, last * block). op_L of the cells [halo, n - halo) reads
+// no ghost cells.
+template <typename Scheme>
+concept SubdomainScheme =
+    requires(const Scheme &s, const std::vector<double> &u,
+             std::vector<double> &out, const typename Scheme::mesh_type &ex,
+             double v, std::size_t i) {
+        { Scheme::halo } -> std::convertible_to<std::size_t>;
+        { Scheme::stage_speed } -> std::convertible_to<bool>;
+        { s.block(ex) } -> std::convertible_to<std::size_t>;
+        { s.max_speed(u, ex, i, i) } -> std::convertible_to<double>;
+        { s.dt(v, ex) } -> std::convertible_to<double>;
+        s.op_L(u, v, ex, out, i, i);
+    };
+
+// optional stage limiter `post_process_rk_stage(u, ex, out, first, last)` of
+// the owned cells [first, last), with the ghost cells and the indexing of
+// op_L, active when stage_limiter() is true
+template <typename Scheme>
+concept SubdomainStageLimiter =
+    requires(const Scheme &s, const std::vector<double> &u,
+             std::vector<double> &out, const typename Scheme::mesh_type &ex,
+             std::size_t i) {
+        { s.stage_limiter() } -> std::convertible_to<bool>;
+        s.post_process_rk_stage(u, ex, out, i, i);
+    };
+
+// 1d scheme in conservation form: face_flux(u, speed, i) is the numerical
+// flux op_L uses at the left face of owned cell i, for i in [0, n], so that
+// L[i] = (face_flux(u, speed, i) - face_flux(u, speed, i + 1)) / dx
+template <typename Scheme>
+concept ConservativeScheme =
+    SubdomainScheme<Scheme>
+    && std::same_as<typename Scheme::mesh_type, Mesh1d>
+    && requires(const Scheme &s, const std::vector<double> &u, double v,
+                std::size_t i) {
+           { s.face_flux(u, v, i) } -> std::convertible_to<double>;
+       };
+
+}  // namespace flux
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace flux {
+// Read-only view of the cells i - Left, ..., i + Right around cell i of a
+// padded buffer (see pad_periodic and solver_threads.hpp): s[k] is u_{i+k}.
+// The bounds are part of the type, so a kernel states the halo it reads, and
+// the offsets of s[-2], ..., s[2] are constants after inlining: a loop over
+// the cells of a slice is a loop over contiguous loads, whichever framework
+// filled the ghost cells.
+template <std::size_t Left, std::size_t Right, typename T = double>
+class Stencil {
+public:
+    static constexpr std::size_t left = Left;
+    static constexpr std::size_t right = Right;
+    static constexpr std::size_t width = Left + Right + 1;
+
+    // cell c of u, with at least Left cells before it and Right after it
+    Stencil(const std::vector<T> &u, std::size_t c) : m_c(u.data() + c) {
+        assert(c >= Left && c + Right < u.size());
+    }
+
+    // the same for a scratch buffer (see scratch_arena.hpp)
+    Stencil(std::span<const T> u, std::size_t c) : m_c(u.data() + c) {
+        assert(c >= Left && c + Right < u.size());
+    }
+
+    T operator[](std::ptrdiff_t k) const {
+        assert(k >= -static_cast<std::ptrdiff_t>(Left)
+               && k <= static_cast<std::ptrdiff_t>(Right));
+        return m_c[k];
+    }
+
+    // u_{i-Left}, ..., u_{i+Right}
+    const T *begin() const { return m_c - Left; }
+
+    const T *end() const { return m_c + Right + 1; }
+
+private:
+    const T *m_c;
+};
+}  // namespace flux
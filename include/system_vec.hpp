@@ -0,0 +1,128 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "solver/requires.h"
+
+namespace flux {
+
+// memory layout of a multi-component state
+enum class Layout {
+    AoS,  // cell by cell: u[i * M + c]
+    SoA,  // component by component: u[c * n + i]
+};
+
+// State of n cells with M components each, a drop-in for Vec in the time
+// integration frameworks. The layout is fixed at compile time, so at(i, c)
+// compiles to the plain index expression of that layout.
+template <std::size_t M, Layout L>
+struct SystemVec {
+    static constexpr std::size_t components = M;
+    static constexpr Layout layout = L;
+
+    // distance between the values of one component in neighbouring cells
+    static constexpr std::size_t stride = (L == Layout::AoS) ? M : 1;
+
+    std::vector<double> data;
+
+    explicit SystemVec(std::vector<double> d)
+        : data(std::move(d)), m_cells(data.size() / M) {}
+
+    SystemVec(const SystemVec &rhs) = default;
+
+    SystemVec &operator=(const SystemVec &rhs) = default;
+
+    SystemVec(SystemVec &&rhs) noexcept = default;
+
+    SystemVec &operator=(SystemVec &&rhs) noexcept = default;
+
+    ~SystemVec() = default;
+
+    std::size_t cells() const { return m_cells; }
+
+    // position of component c of cell i among n cells
+    static constexpr std::size_t index(std::size_t n, std::size_t i,
+                                       std::size_t c) {
+        if constexpr (L == Layout::AoS) {
+            return i * M + c;
+        }
+        else {
+            return c * n + i;
+        }
+    }
+
+    double &at(std::size_t i, std::size_t c) {
+        return data[index(m_cells, i, c)];
+    }
+
+    double at(std::size_t i, std::size_t c) const {
+        return data[index(m_cells, i, c)];
+    }
+
+    // component c of cell i is component(c)[i * stride]
+    double *component(std::size_t c) {
+        return data.data() + index(m_cells, 0, c);
+    }
+
+    const double *component(std::size_t c) const {
+        return data.data() + index(m_cells, 0, c);
+    }
+
+    std::array<double, M> get(std::size_t i) const {
+        std::array<double, M> result{};
+        for (std::size_t c = 0; c < M; c++) result[c] = at(i, c);
+        return result;
+    }
+
+    void set(std::size_t i, const std::array<double, M> &v) {
+        for (std::size_t c = 0; c < M; c++) at(i, c) = v[c];
+    }
+
+    SystemVec operator+(const SystemVec &rhs) const {
+        SystemVec result(data);
+        for (std::size_t i = 0; i < data.size(); ++i) {
+            result.data[i] += rhs.data[i];
+        }
+        return result;
+    }
+
+    SystemVec operator-(const SystemVec &rhs) const {
+        SystemVec result(data);
+        for (std::size_t i = 0; i < data.size(); ++i) {
+            result.data[i] -= rhs.data[i];
+        }
+        return result;
+    }
+
+    friend SystemVec operator*(double scalar, const SystemVec &vec) {
+        SystemVec result(vec);
+        for (auto &v : result.data) { v *= scalar; }
+        return result;
+    }
+
+private:
+    std::size_t m_cells;
+};
+
+// u extended by halo periodic ghost cells on each side, in the same layout
+template <std::size_t M, Layout L>
+SystemVec<M, L> pad_periodic(const SystemVec<M, L> &u, std::size_t halo) {
+    const std::size_t n = u.cells();
+    auto result = SystemVec<M, L>(std::vector<double>((n + 2 * halo) * M));
+    for (std::size_t c = 0; c < M; c++) {
+        for (std::size_t k = 0; k < n + 2 * halo; k++) {
+            result.at(k, c) = u.at((k + n * (halo / n + 1) - halo) % n, c);
+        }
+    }
+    return result;
+}
+
+static_assert(VarRequirements<SystemVec<3, Layout::AoS>>,
+              "SystemVec does not satisfy VarRequirements!");
+static_assert(VarRequirements<SystemVec<3, Layout::SoA>>,
+              "SystemVec does not satisfy VarRequirements!");
+
+}  // namespace flux
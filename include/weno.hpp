@@ -0,0 +1,344 @@
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "period_index.hpp"
+#include "scratch_arena.hpp"
+#include "stencil.hpp"
+#include "weno_weights.hpp"
+
+namespace flux {
+// WENO reconstruction of order 2R - 1 from R candidate stencils of R cells.
+// The stencil coefficients, linear weights and smoothness indicators are
+// generated at compile time (weno_tables<R>); weno_point<R> unrolls every
+// loop over them, so the kernel compiles to straight-line code like the
+// hand-written weno5_point. R = 3, 4, 5 give WENO5, WENO7 and WENO9.
+
+namespace detail {
+template <std::size_t N>
+using Matrix = std::array<std::array<double, N>, N>;
+
+constexpr double abs_value(double x) { return x < 0 ? -x : x; }
+
+// integral of x^m over [a, b]
+constexpr double monomial_integral(double a, double b, std::size_t m) {
+    double pa = a;
+    double pb = b;
+    for (std::size_t k = 0; k < m; k++) {
+        pa *= a;
+        pb *= b;
+    }
+    return (pb - pa) / static_cast<double>(m + 1);
+}
+
+// Gauss-Jordan elimination with partial pivoting
+template <std::size_t N>
+constexpr Matrix<N> inverse(Matrix<N> a) {
+    Matrix<N> inv{};
+    for (std::size_t i = 0; i < N; i++) inv[i][i] = 1;
+
+    for (std::size_t col = 0; col < N; col++) {
+        std::size_t p = col;
+        for (std::size_t r = col + 1; r < N; r++) {
+            if (abs_value(a[r][col]) > abs_value(a[p][col])) p = r;
+        }
+        std::swap(a[p], a[col]);
+        std::swap(inv[p], inv[col]);
+
+        double s = a[col][col];
+        for (std::size_t j = 0; j < N; j++) {
+            a[col][j] /= s;
+            inv[col][j] /= s;
+        }
+        for (std::size_t r = 0; r < N; r++) {
+            if (r == col) continue;
+            double f = a[r][col];
+            for (std::size_t j = 0; j < N; j++) {
+                a[r][j] -= f * a[col][j];
+                inv[r][j] -= f * inv[col][j];
+            }
+        }
+    }
+    return inv;
+}
+
+// The polynomial p of degree N - 1 with the averages u_0, ..., u_{N-1} over
+// N neighbouring cells, p(x) = sum_m x^m sum_j P[m][j] u_j. Lengths are in
+// units of dx and x = 0 is the centre of the stencil, which keeps the
+// moment matrix well conditioned.
+template <std::size_t N>
+constexpr Matrix<N> average_interpolant() {
+    constexpr double half = static_cast<double>(N) / 2;
+    Matrix<N> a{};
+    for (std::size_t j = 0; j < N; j++) {
+        double lo = static_cast<double>(j) - half;
+        for (std::size_t m = 0; m < N; m++) {
+            a[j][m] = monomial_integral(lo, lo + 1, m);
+        }
+    }
+    return inverse(a);
+}
+
+// Weights of the averages u_0, ..., u_{N-1} of the cells i - r, ...,
+// i - r + N - 1 in the value at x_{i+1/2}, r >= -1 (Shu, NASA/CR-97-206253,
+// eq. 2.21).
+// Sums of integer products with one division per term, so the weights are
+// exact up to rounding, unlike p(1/2) from the inverse above.
+template <std::size_t N>
+constexpr std::array<double, N> trace_weights(double r) {
+    std::array<double, N> result{};
+    for (std::size_t j = 0; j < N; j++) {
+        for (std::size_t m = j + 1; m <= N; m++) {
+            double num = 0;
+            for (std::size_t l = 0; l <= N; l++) {
+                if (l == m) continue;
+                double prod = 1;
+                for (std::size_t q = 0; q <= N; q++) {
+                    if (q == m || q == l) continue;
+                    prod *= r - static_cast<double>(q) + 1;
+                }
+                num += prod;
+            }
+            double den = 1;
+            for (std::size_t l = 0; l <= N; l++) {
+                if (l == m) continue;
+                den *= static_cast<double>(m) - static_cast<double>(l);
+            }
+            result[j] += num / den;
+        }
+    }
+    return result;
+}
+}  // namespace detail
+
+// Cell i with the 2R - 1 averages u_0, ..., u_{2R-2} = u_{i-R+1}, ...,
+// u_{i+R-1}; stencil k covers u_k, ..., u_{k+R-1}.
+template <std::size_t R>
+struct WenoTables {
+    // right[k][j] is the weight of u_{k+j} in the trace x_{i+1/2}^- of
+    // stencil k, left[k][j] in x_{i-1/2}^+
+    std::array<std::array<double, R>, R> right{};
+    std::array<std::array<double, R>, R> left{};
+
+    // linear weights, the combination of order 2R - 1
+    std::array<double, R> d_right{};
+    std::array<double, R> d_left{};
+
+    // The Jiang-Shu indicator of stencil k in the differences
+    // du_j = u_{j+1} - u_j as a sum of squares (LDL^T factorization),
+    // b_k = sum_m lambda[k][m] (sum_{j >= m} ldl[k][m][j] du_{k+j})^2,
+    // ldl[k][m][m] = 1.
+    std::array<std::array<double, R - 1>, R> lambda{};
+    std::array<std::array<std::array<double, R - 1>, R - 1>, R> ldl{};
+};
+
+namespace detail {
+constexpr double binomial(std::size_t n, std::size_t k) {
+    double result = 1;
+    for (std::size_t j = 1; j <= k; j++) {
+        result = result * static_cast<double>(n + 1 - j) / static_cast<double>(j);
+    }
+    return result;
+}
+
+template <std::size_t R>
+constexpr WenoTables<R> make_weno_tables() {
+    static_assert(R >= 2, "WENO needs at least two candidate stencils");
+    WenoTables<R> t{};
+
+    // stencil k starts R - 1 - k cells left of cell i and R - 2 - k cells
+    // left of cell i - 1, whose x_{i+1/2} is x_{i-1/2} of cell i
+    constexpr auto shift = static_cast<double>(R - 1);
+    for (std::size_t k = 0; k < R; k++) {
+        t.right[k] = trace_weights<R>(shift - static_cast<double>(k));
+        t.left[k] = trace_weights<R>(shift - static_cast<double>(k) - 1);
+    }
+
+    // d_k = C(R, k) C(R - 1, k) / C(2R - 1, R - 1) for x_{i+1/2}, mirrored
+    // for x_{i-1/2}; checked against the full stencil below
+    for (std::size_t k = 0; k < R; k++) {
+        t.d_right[k] =
+            binomial(R, k) * binomial(R - 1, k) / binomial(2 * R - 1, R - 1);
+        t.d_left[R - 1 - k] = t.d_right[k];
+    }
+
+    // cell i is [-1/2, 1/2] around the stencil centre shifted by -c
+    constexpr auto P = average_interpolant<R>();
+    for (std::size_t k = 0; k < R; k++) {
+        double c = static_cast<double>(k) - static_cast<double>(R - 1) / 2;
+
+        // sum_{l >= 1} integral over cell i of (d^l p / dx^l)^2 as the
+        // quadratic form B of u
+        Matrix<R> B{};
+        for (std::size_t l = 1; l < R; l++) {
+            for (std::size_t m = l; m < R; m++) {
+                for (std::size_t q = l; q < R; q++) {
+                    double fm = 1;
+                    double fq = 1;
+                    for (std::size_t s = 0; s < l; s++) {
+                        fm *= static_cast<double>(m - s);
+                        fq *= static_cast<double>(q - s);
+                    }
+                    double w = fm * fq
+                               * monomial_integral(-0.5 - c, 0.5 - c,
+                                                   m + q - 2 * l);
+                    for (std::size_t a = 0; a < R; a++) {
+                        for (std::size_t b = 0; b < R; b++) {
+                            B[a][b] += w * P[m][a] * P[q][b];
+                        }
+                    }
+                }
+            }
+        }
+
+        // B in the differences, u_a = u_0 + sum_{j < a} du_j
+        Matrix<R - 1> D{};
+        for (std::size_t i = 0; i < R - 1; i++) {
+            for (std::size_t j = 0; j < R - 1; j++) {
+                for (std::size_t a = i + 1; a < R; a++) {
+                    for (std::size_t b = j + 1; b < R; b++) {
+                        D[i][j] += B[a][b];
+                    }
+                }
+            }
+        }
+
+        // D = L diag(lambda) L^T, ldl[k][m][j] = L[j][m]
+        auto &lam = t.lambda[k];
+        auto &L = t.ldl[k];
+        for (std::size_t j = 0; j < R - 1; j++) {
+            double s = D[j][j];
+            for (std::size_t m = 0; m < j; m++) {
+                s -= L[m][j] * L[m][j] * lam[m];
+            }
+            lam[j] = s;
+            L[j][j] = 1;
+            for (std::size_t i = j + 1; i < R - 1; i++) {
+                double v = D[i][j];
+                for (std::size_t m = 0; m < j; m++) {
+                    v -= L[m][i] * L[m][j] * lam[m];
+                }
+                L[j][i] = v / lam[j];
+            }
+        }
+    }
+    return t;
+}
+
+// the linear weights combine the stencils to the full stencil of 2R - 1 cells
+template <std::size_t R>
+constexpr bool consistent(const WenoTables<R> &t) {
+    constexpr auto shift = static_cast<double>(R - 1);
+    const auto full_r = trace_weights<2 * R - 1>(shift);
+    const auto full_l = trace_weights<2 * R - 1>(shift - 1);
+    for (std::size_t j = 0; j < 2 * R - 1; j++) {
+        double s_r = full_r[j];
+        double s_l = full_l[j];
+        for (std::size_t k = 0; k < R; k++) {
+            if (j < k || j - k >= R) continue;
+            s_r -= t.d_right[k] * t.right[k][j - k];
+            s_l -= t.d_left[k] * t.left[k][j - k];
+        }
+        if (abs_value(s_r) > 1e-12 || abs_value(s_l) > 1e-12) return false;
+    }
+    return true;
+}
+
+// f(integral_constant<I>) for I = 0, ..., N - 1
+template <std::size_t N, typename Func>
+constexpr void unroll(Func &&f) {
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        (f(std::integral_constant<std::size_t, I>{}), ...);
+    }(std::make_index_sequence<N>{});
+}
+}  // namespace detail
+
+template <std::size_t R>
+inline constexpr WenoTables<R> weno_tables = detail::make_weno_tables<R>();
+
+static_assert(detail::consistent(weno_tables<3>));
+static_assert(detail::consistent(weno_tables<4>));
+static_assert(detail::consistent(weno_tables<5>));
+
+// reconstruct the left (x_{i-1/2}^+) and right (x_{i+1/2}^-) values of cell i
+// from the averages u[0], ..., u[2R - 2] = u_{i-R+1}, ..., u_{i+R-1}, all
+// arithmetic in T, with the nonlinear weights of the policy W
+template <std::size_t R, WenoWeights W = WenoJS, std::floating_point T>
+inline void weno_point(const T *u, T &res_ul, T &res_ur) {
+    constexpr auto &tab = weno_tables<R>;
+    const auto c = [](double v) { return static_cast<T>(v); };
+
+    // local copy, the results may alias u
+    std::array<T, 2 * R - 1> v{};
+    detail::unroll<2 * R - 1>([&](auto j) { v[j] = u[j]; });
+
+    std::array<T, 2 * R - 2> du{};
+    detail::unroll<2 * R - 2>([&](auto j) { du[j] = v[j + 1] - v[j]; });
+
+    // smooth indicator
+    std::array<T, R> b{};
+    detail::unroll<R>([&](auto k) {
+        detail::unroll<R - 1>([&](auto m) {
+            T s = 0;
+            detail::unroll<R - 1 - m>([&](auto q) {
+                s += c(tab.ldl[k][m][m + q]) * du[k + m + q];
+            });
+            b[k] += c(tab.lambda[k][m]) * s * s;
+        });
+    });
+
+    std::array<T, R> d_l{};
+    std::array<T, R> d_r{};
+    detail::unroll<R>([&](auto k) {
+        d_l[k] = c(tab.d_left[k]);
+        d_r[k] = c(tab.d_right[k]);
+    });
+
+    // Normalized nonlinear weight
+    auto w_l = W::weights(b, d_l);
+    auto w_r = W::weights(b, d_r);
+
+    T sum_l = 0;
+    T sum_r = 0;
+    detail::unroll<R>([&](auto k) {
+        T u_l = 0;
+        T u_r = 0;
+        detail::unroll<R>([&](auto j) {
+            u_l += c(tab.left[k][j]) * v[k + j];
+            u_r += c(tab.right[k][j]) * v[k + j];
+        });
+        sum_l += w_l[k] * u_l;
+        sum_r += w_r[k] * u_r;
+    });
+    res_ul = sum_l;
+    res_ur = sum_r;
+}
+
+// the same from the stencil of cell i
+template <std::size_t R, WenoWeights W = WenoJS, std::floating_point T>
+inline void weno_point(const Stencil<R - 1, R - 1, T> &s, T &res_ul,
+                       T &res_ur) {
+    weno_point<R, W>(s.begin(), res_ul, res_ur);
+}
+
+// periodic, res_ul and res_ur keep their storage if it is large enough
+template <std::size_t R, WenoWeights W = WenoJS, std::floating_point T>
+inline void weno(const std::vector<T> &u, std::vector<T> &res_ul,
+                 std::vector<T> &res_ur) {
+    size_t n = u.size();
+    res_ul.resize(n);
+    res_ur.resize(n);
+    auto &arena = scratch_arena<T>();
+    auto frame = arena.frame();
+    auto &pad = arena.vector(n + 2 * (R - 1));
+    pad_periodic(u, R - 1, 1, pad);
+    for (size_t i = 0; i < n; i++) {
+        auto s = Stencil<R - 1, R - 1, T>(pad, i + R - 1);
+        weno_point<R, W>(s, res_ul[i], res_ur[i]);
+    }
+}
+}  // namespace flux
@@ -1,81 +1,83 @@
 #pragma once
 
+#include <array>
+#include <concepts>
 #include <vector>
 
 #include "period_index.hpp"
+#include "scratch_arena.hpp"
+#include "stencil.hpp"
+#include "weno_weights.hpp"
 
 namespace flux {
-inline void weno5(std::vector<double> u, std::vector<double> &res_ul,
-                  std::vector<double> &res_ur) {
+// reconstruct the left (x_{i-1/2}^+) and right (x_{i+1/2}^-) values of cell i
+// from the cell averages u_{i-2}, ..., u_{i+2}, all arithmetic in T, with the
+// nonlinear weights of the policy W (weno_weights.hpp)
+template <WenoWeights W = WenoJS, std::floating_point T>
+inline void weno5_point(T um2, T um1, T u0, T up1, T up2, T &res_ul,
+                        T &res_ur) {
     // linear weight
-    constexpr double d_l0 = 3.0 / 10;
-    constexpr double d_l1 = 3.0 / 5;
-    constexpr double d_l2 = 1.0 / 10;
-    constexpr double d_r0 = 1.0 / 10;
-    constexpr double d_r1 = 3.0 / 5;
-    constexpr double d_r2 = 3.0 / 10;
+    constexpr std::array<T, 3> d_l = {static_cast<T>(3.0 / 10),
+                                      static_cast<T>(3.0 / 5),
+                                      static_cast<T>(1.0 / 10)};
+    constexpr std::array<T, 3> d_r = {static_cast<T>(1.0 / 10),
+                                      static_cast<T>(3.0 / 5),
+                                      static_cast<T>(3.0 / 10)};
 
-    // Important, avoid denominator being 0 and not too small
-    constexpr double weno_ep = 1e-6;
-
-    const auto cb = [](double u0, double u1, double u2, double c0, double c1,
-                       double c2) { return c0 * u0 + c1 * u1 + c2 * u2; };
-    const auto cb2 = [](double u0, double u1, double c0, double c1) {
-        return c0 * u0 * u0 + c1 * u1 * u1;
+    // the coefficients are rounded to T
+    const auto cb = [](T v0, T v1, T v2, double c0, double c1, double c2) {
+        return static_cast<T>(c0) * v0 + static_cast<T>(c1) * v1
+               + static_cast<T>(c2) * v2;
+    };
+    const auto cb2 = [](T v0, T v1, double c0, double c1) {
+        return static_cast<T>(c0) * v0 * v0 + static_cast<T>(c1) * v1 * v1;
     };
 
-    size_t n = u.size();
-    res_ul = std::vector<double>(n);
-    res_ur = std::vector<double>(n);
-    for (size_t i = 0; i < n; i++) {
-        auto idx = PeriodIndex(n, i);
+    // smooth indicator
+    std::array<T, 3> b = {
+        cb2(cb(um2, um1, u0, 1, -2, 1), cb(um2, um1, u0, 1, -4, 3),  //
+            13.0 / 12, 1.0 / 4),
+        cb2(cb(um1, u0, up1, 1, -2, 1), cb(um1, u0, up1, 1, 0, -1),  //
+            13.0 / 12, 1.0 / 4),
+        cb2(cb(u0, up1, up2, 1, -2, 1), cb(u0, up1, up2, 3, -4, 1),  //
+            13.0 / 12, 1.0 / 4),
+    };
 
-        // smooth indicator
-        double b0 = cb2(cb(u[idx.l(2)], u[idx.l()], u[idx.c()], 1, -2, 1),
-                        cb(u[idx.l(2)], u[idx.l()], u[idx.c()], 1, -4, 3),  //
-                        13.0 / 12, 1.0 / 4);
-        double b1 = cb2(cb(u[idx.l()], u[idx.c()], u[idx.r()], 1, -2, 1),
-                        cb(u[idx.l()], u[idx.c()], u[idx.r()], 1, 0, -1),  //
-                        13.0 / 12, 1.0 / 4);
-        double b2 = cb2(cb(u[idx.c()], u[idx.r()], u[idx.r(2)], 1, -2, 1),
-                        cb(u[idx.c()], u[idx.r()], u[idx.r(2)], 3, -4, 1),  //
-                        13.0 / 12, 1.0 / 4);
+    // Normalized nonlinear weight
+    auto w_l = W::weights(b, d_l);
+    auto w_r = W::weights(b, d_r);
 
-        // Nonlinear weight
-        double a_l0 = d_l0 / ((b0 + weno_ep) * (b0 + weno_ep));
-        double a_l1 = d_l1 / ((b1 + weno_ep) * (b1 + weno_ep));
-        double a_l2 = d_l2 / ((b2 + weno_ep) * (b2 + weno_ep));
-        double a_r0 = d_r0 / ((b0 + weno_ep) * (b0 + weno_ep));
-        double a_r1 = d_r1 / ((b1 + weno_ep) * (b1 + weno_ep));
-        double a_r2 = d_r2 / ((b2 + weno_ep) * (b2 + weno_ep));
+    T u_l0 = cb(um2, um1, u0, -1.0 / 6, 5.0 / 6, 1.0 / 3);
+    T u_l1 = cb(um1, u0, up1, 1.0 / 3, 5.0 / 6, -1.0 / 6);
+    T u_l2 = cb(u0, up1, up2, 11.0 / 6, -7.0 / 6, 1.0 / 3);
 
-        // Normalized nonlinear weight
-        double a_l_sum = a_l0 + a_l1 + a_l2;
-        double a_r_sum = a_r0 + a_r1 + a_r2;
-        double w_l0 = a_l0 / a_l_sum;
-        double w_l1 = a_l1 / a_l_sum;
-        double w_l2 = a_l2 / a_l_sum;
-        double w_r0 = a_r0 / a_r_sum;
-        double w_r1 = a_r1 / a_r_sum;
-        double w_r2 = a_r2 / a_r_sum;
+    T u_r0 = cb(um2, um1, u0, 1.0 / 3, -7.0 / 6, 11.0 / 6);
+    T u_r1 = cb(um1, u0, up1, -1.0 / 6, 5.0 / 6, 1.0 / 3);
+    T u_r2 = cb(u0, up1, up2, 1.0 / 3, 5.0 / 6, -1.0 / 6);
 
-        double u_l0 = cb(u[idx.l(2)], u[idx.l()], u[idx.c()],  //
-                         -1.0 / 6, 5.0 / 6, 1.0 / 3);
-        double u_l1 = cb(u[idx.l()], u[idx.c()], u[idx.r()],  //
-                         1.0 / 3, 5.0 / 6, -1.0 / 6);
-        double u_l2 = cb(u[idx.c()], u[idx.r()], u[idx.r(2)],  //
-                         11.0 / 6, -7.0 / 6, 1.0 / 3);
+    res_ul = w_l[0] * u_l0 + w_l[1] * u_l1 + w_l[2] * u_l2;
+    res_ur = w_r[0] * u_r0 + w_r[1] * u_r1 + w_r[2] * u_r2;
+}
 
-        double u_r0 = cb(u[idx.l(2)], u[idx.l()], u[idx.c()],  //
-                         1.0 / 3, -7.0 / 6, 11.0 / 6);
-        double u_r1 = cb(u[idx.l()], u[idx.c()], u[idx.r()],  //
-                         -1.0 / 6, 5.0 / 6, 1.0 / 3);
-        double u_r2 = cb(u[idx.c()], u[idx.r()], u[idx.r(2)],  //
-                         1.0 / 3, 5.0 / 6, -1.0 / 6);
+// the same from the stencil u_{i-2}, ..., u_{i+2} of cell i
+template <WenoWeights W = WenoJS, std::floating_point T>
+inline void weno5_point(const Stencil<2, 2, T> &s, T &res_ul, T &res_ur) {
+    weno5_point<W>(s[-2], s[-1], s[0], s[1], s[2], res_ul, res_ur);
+}
 
-        res_ul[idx.c()] = w_l0 * u_l0 + w_l1 * u_l1 + w_l2 * u_l2;
-        res_ur[idx.c()] = w_r0 * u_r0 + w_r1 * u_r1 + w_r2 * u_r2;
+// periodic, res_ul and res_ur keep their storage if it is large enough
+template <WenoWeights W = WenoJS, std::floating_point T>
+inline void weno5(const std::vector<T> &u, std::vector<T> &res_ul,
+                  std::vector<T> &res_ur) {
+    size_t n = u.size();
+    res_ul.resize(n);
+    res_ur.resize(n);
+    auto &arena = scratch_arena<T>();
+    auto frame = arena.frame();
+    auto &pad = arena.vector(n + 4);
+    pad_periodic(u, 2, 1, pad);
+    for (size_t i = 0; i < n; i++) {
+        weno5_point<W>(Stencil<2, 2, T>(pad, i + 2), res_ul[i], res_ur[i]);
     }
-    return;
 }
 }  // namespace flux
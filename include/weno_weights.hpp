@@ -0,0 +1,112 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+
+namespace flux {
+
+// Nonlinear weights of a WENO reconstruction as a compile-time policy: from
+// the smoothness indicators b_k and the linear weights d_k of the N
+// candidate stencils, return the normalized weights w_k.
+template <typename W>
+concept WenoWeights = requires(const std::array<double, 3> &b) {
+    { W::weights(b, b) } -> std::same_as<std::array<double, 3>>;
+};
+
+namespace detail {
+// ep of WenoZ and WenoM, 1e-40 in double, larger in float so that ep^2 does
+// not underflow
+template <std::floating_point T>
+constexpr T tiny_ep =
+    static_cast<T>(sizeof(T) < sizeof(double) ? 1e-18 : 1e-40);
+
+template <std::floating_point T, std::size_t N>
+std::array<T, N> normalize(std::array<T, N> a) {
+    T sum = 0;
+    for (auto v : a) sum += v;
+    for (auto &v : a) v /= sum;
+    return a;
+}
+}  // namespace detail
+
+// Jiang and Shu, a_k = d_k / (b_k + ep)^2
+struct WenoJS {
+    template <std::floating_point T, std::size_t N>
+    static std::array<T, N> weights(const std::array<T, N> &b,
+                                    const std::array<T, N> &d) {
+        // Important, avoid denominator being 0 and not too small
+        constexpr T ep = static_cast<T>(1e-6);
+
+        std::array<T, N> a{};
+        for (std::size_t k = 0; k < N; k++) {
+            a[k] = d[k] / ((b[k] + ep) * (b[k] + ep));
+        }
+        return detail::normalize(a);
+    }
+};
+
+// Borges et al., a_k = d_k (1 + (tau / (b_k + ep))^2) with a global
+// indicator tau of order 2N - 1 or higher; closer to the linear weights in
+// smooth regions, also at critical points
+struct WenoZ {
+    // Borges et al. for N = 3, Castro et al. for N = 4, 5
+    template <std::floating_point T, std::size_t N>
+    static T global_indicator(const std::array<T, N> &b) {
+        static_assert(N >= 3 && N <= 5, "WenoZ has tau for N = 3, 4, 5");
+        if constexpr (N == 3) {
+            return std::abs(b[0] - b[2]);
+        }
+        else if constexpr (N == 4) {
+            return std::abs(b[0] + 3 * b[1] - 3 * b[2] - b[3]);
+        }
+        else {
+            return std::abs(b[0] + 2 * b[1] - 6 * b[2] + 2 * b[3] + b[4]);
+        }
+    }
+
+    template <std::floating_point T, std::size_t N>
+    static std::array<T, N> weights(const std::array<T, N> &b,
+                                    const std::array<T, N> &d) {
+        constexpr T ep = detail::tiny_ep<T>;
+        const T tau = global_indicator(b);
+
+        std::array<T, N> a{};
+        for (std::size_t k = 0; k < N; k++) {
+            T q = tau / (b[k] + ep);
+            a[k] = d[k] * (1 + q * q);
+        }
+        return detail::normalize(a);
+    }
+};
+
+// Henrick et al., the Jiang-Shu weights (ep = tiny_ep) mapped by
+// g_k(w) = w (d_k + d_k^2 - 3 d_k w + w^2) / (d_k^2 + w (1 - 2 d_k)),
+// which is flat at w = d_k; about twice the cost of WenoJS
+struct WenoM {
+    template <std::floating_point T, std::size_t N>
+    static std::array<T, N> weights(const std::array<T, N> &b,
+                                    const std::array<T, N> &d) {
+        constexpr T ep = detail::tiny_ep<T>;
+
+        std::array<T, N> w{};
+        for (std::size_t k = 0; k < N; k++) {
+            w[k] = d[k] / ((b[k] + ep) * (b[k] + ep));
+        }
+        w = detail::normalize(w);
+
+        std::array<T, N> a{};
+        for (std::size_t k = 0; k < N; k++) {
+            a[k] = w[k] * (d[k] + d[k] * d[k] - 3 * d[k] * w[k] + w[k] * w[k])
+                   / (d[k] * d[k] + w[k] * (1 - 2 * d[k]));
+        }
+        return detail::normalize(a);
+    }
+};
+
+static_assert(WenoWeights<WenoJS>);
+static_assert(WenoWeights<WenoZ>);
+static_assert(WenoWeights<WenoM>);
+
+}  // namespace flux
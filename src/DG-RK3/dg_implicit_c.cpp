@@ -0,0 +1,178 @@
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+
+#include "dg_test.hpp"
+
+#include "schemes/dg.hpp"
+#include "solver/solver_crtp.hpp"
+#include "solver/solver_implicit.hpp"
+
+using namespace flux;                // NOLINT
+using flux::solver_crtp::RK3Solver;  // NOLINT
+using namespace flux::solver_implicit;  // NOLINT
+
+template <typename D>
+using BackwardEulerBase = DIRKSolver<BackwardEuler, D>;
+template <typename D>
+using SDIRK2Base = DIRKSolver<SDIRK2, D>;
+template <typename D>
+using SDIRK3Base = DIRKSolver<SDIRK3, D>;
+
+// DG on the integrator Base, dt = cfl dx / ((2k + 1) max |f'(u)|), cfl = 1
+// is the explicit limit of RK3. Newton only needs loose linear solves,
+// Rosenbrock tight ones.
+template <template <typename> class Base>
+class ImplicitDG : public Base<ImplicitDG<Base>> {
+public:
+    ImplicitDG(size_t DG_k, size_t gauss_k, double cfl,
+               double krylov_rtol = 1e-4)
+        : m_scheme(DG_k, gauss_k), m_cfl(cfl), m_krylov_rtol(krylov_rtol) {}
+
+    double get_dt(const Vec &var, Mesh1d &ex, double t) const {
+        size_t cell_num = var.data.size() / (m_scheme.DG_k() + 1);
+        double df_max = m_scheme.max_speed(var.data, ex, 0, cell_num);
+        auto coeff = static_cast<double>(2 * m_scheme.DG_k() + 1);
+        return m_cfl * ex.dx / (coeff * df_max);
+    }
+
+    Vec op_L(const Vec &var, Mesh1d &ex, double t) const {
+        m_op_L_calls++;
+        return m_scheme.op_L(var, ex, t);
+    }
+
+    // block-Jacobi on the DG cells
+    NewtonKrylovConfig newton_krylov_config(const Mesh1d &ex) const {
+        auto cfg = NewtonKrylovConfig{};
+        cfg.block = m_scheme.DG_k() + 1;
+        cfg.krylov_rtol = m_krylov_rtol;
+        return cfg;
+    }
+
+    size_t op_L_calls() const { return m_op_L_calls; }
+
+private:
+    schemes::DG m_scheme;
+    double m_cfl;
+    double m_krylov_rtol;
+    mutable size_t m_op_L_calls{0};
+};
+
+constexpr double ros2_rtol = 1e-6;
+
+// the explicit reference, dt of BasicDG (dx^{(k+1)/3} for k > 2)
+class ExplicitDG : public RK3Solver<Vec, Mesh1d, ExplicitDG> {
+public:
+    ExplicitDG(size_t DG_k, size_t gauss_k) : m_scheme(DG_k, gauss_k) {}
+
+    double get_dt(const Vec &var, Mesh1d &ex, double t) const {
+        return m_scheme.get_dt(var, ex, t);
+    }
+
+    Vec op_L(const Vec &var, Mesh1d &ex, double t) const {
+        m_op_L_calls++;
+        return m_scheme.op_L(var, ex, t);
+    }
+
+    size_t op_L_calls() const { return m_op_L_calls; }
+
+private:
+    schemes::DG m_scheme;
+    mutable size_t m_op_L_calls{0};
+};
+
+struct Work {
+    size_t op_L_calls;
+    double seconds;
+    double error_l1;
+};
+
+// one run on n cells
+template <typename Init, typename Exact, typename SolverType>
+Work measure(const Config<Init, Exact> &cfg, const SolverType &proto,
+             size_t DG_k, size_t n) {
+    double dx = 0;
+    auto x = linespace_mid(cfg.xl, cfg.xr, n, dx);
+    auto uh = modal_projection(cfg.init, x, dx, DG_k, cfg.gauss_k);
+    auto ex = Mesh1d{dx};
+
+    auto solver = proto;
+    auto start = std::chrono::steady_clock::now();
+    uh = solver.run(Vec{uh}, ex, 0, cfg.tend).value().data;
+    auto stop = std::chrono::steady_clock::now();
+
+    auto errs = modal_error_norms(
+        uh, [&](double s) { return cfg.exact(s, cfg.tend); }, x, dx, DG_k,
+        cfg.gauss_k);
+    return {solver.op_L_calls(),
+            std::chrono::duration<double>(stop - start).count(), errs.l1};
+}
+
+int main() {
+    // k = 3 keeps the spatial error below the temporal one
+    size_t DG_k = 3;
+    size_t gauss_k = 7;
+    double cfl = 2;
+
+    auto cfg = order_test_config();
+    cfg.gauss_k = gauss_k;
+    cfg.nlist = {10, 20, 40, 80, 160};
+
+    // temporal order at a fixed multiple of the explicit limit
+    std::cout << "backward Euler\n";
+    DG_order_test(cfg, ImplicitDG<BackwardEulerBase>{DG_k, gauss_k, cfl},
+                  DG_k, OUTPUT_DIR "/order_be_c.csv");
+    std::cout << "SDIRK2\n";
+    DG_order_test(cfg, ImplicitDG<SDIRK2Base>{DG_k, gauss_k, cfl}, DG_k,
+                  OUTPUT_DIR "/order_sdirk2_c.csv");
+    std::cout << "SDIRK3\n";
+    DG_order_test(cfg, ImplicitDG<SDIRK3Base>{DG_k, gauss_k, cfl}, DG_k,
+                  OUTPUT_DIR "/order_sdirk3_c.csv");
+    std::cout << "ROS2\n";
+    DG_order_test(cfg,
+                  ImplicitDG<RosenbrockSolver>{DG_k, gauss_k, cfl, ros2_rtol},
+                  DG_k, OUTPUT_DIR "/order_ros2_c.csv");
+
+    // work against the explicit RK3 on the finest grid
+    const size_t n = cfg.nlist.back();
+    struct Row {
+        const char *name;
+        double cfl;
+        Work work;
+    };
+    std::vector<Row> rows = {
+        {"RK3", 0, measure(cfg, ExplicitDG{DG_k, gauss_k}, DG_k, n)},
+    };
+    for (double c : {1.0, 4.0, 16.0}) {
+        rows.push_back({"SDIRK3", c,
+                        measure(cfg, ImplicitDG<SDIRK3Base>{DG_k, gauss_k, c},
+                                DG_k, n)});
+    }
+    for (double c : {4.0, 16.0}) {
+        rows.push_back(
+            {"ROS2", c,
+             measure(cfg,
+                     ImplicitDG<RosenbrockSolver>{DG_k, gauss_k, c, ros2_rtol},
+                     DG_k, n)});
+    }
+
+    const char *filename = OUTPUT_DIR "/implicit_c.csv";
+    std::fstream f(filename, std::ios::out);
+    if (f.fail()) {
+        std::cerr << "fail to open file " << filename << std::endl;
+        exit(1);
+    }
+    f << "integrator,cfl,op_L_calls,seconds,error_1\n";
+    std::printf("n = %zu, DG_k = %zu\n", n, DG_k);
+    std::printf("%-8s %6s %12s %10s %12s\n", "method", "cfl", "op_L calls",
+                "seconds", "error_1");
+    for (const auto &r : rows) {
+        f << r.name << ',' << r.cfl << ',' << r.work.op_L_calls << ','
+          << r.work.seconds << ',' << r.work.error_l1 << '\n';
+        std::printf("%-8s %6.1f %12zu %10.4f %12.2e\n", r.name, r.cfl,
+                    r.work.op_L_calls, r.work.seconds, r.work.error_l1);
+    }
+    std::cout << "export to file " << filename << '\n';
+
+    return 0;
+}
@@ -0,0 +1,46 @@
+#include "dg_test.hpp"
+
+#include "schemes/dg.hpp"
+#include "solver/solver_crtp.hpp"
+
+using namespace flux;                // NOLINT
+using flux::solver_crtp::RK3Solver;  // NOLINT
+
+// the same scheme for any flux policy F, inlined at compile time
+template <FluxPolicy F>
+class LawSolver : public RK3Solver<Vec, Mesh1d, LawSolver<F>> {
+public:
+    LawSolver(size_t DG_k, size_t gauss_k) : m_scheme(DG_k, gauss_k) {}
+
+    double get_dt(const Vec &var, Mesh1d &ex, double t) const {
+        return m_scheme.get_dt(var, ex, t);
+    }
+
+    Vec op_L(const Vec &var, Mesh1d &ex, double t) const {
+        return m_scheme.op_L(var, ex, t);
+    }
+
+    auto cache_key() const { return std::tie(m_scheme); }
+
+private:
+    schemes::BasicDG<F> m_scheme;
+};
+
+int main() {
+    size_t DG_k = 2;
+    size_t gauss_k = 7;
+
+    std::cout << "linear advection\n";
+    auto cfg_a = linear_advection_config();
+    cfg_a.gauss_k = gauss_k;
+    DG_order_test(cfg_a, LawSolver<LinearAdvection<>>{DG_k, gauss_k}, DG_k,
+                  OUTPUT_DIR "/order_advection_c.csv");
+
+    std::cout << "Buckley-Leverett\n";
+    auto cfg_b = buckley_leverett_config();
+    cfg_b.gauss_k = gauss_k;
+    DG_order_test(cfg_b, LawSolver<BuckleyLeverett<>>{DG_k, gauss_k}, DG_k,
+                  OUTPUT_DIR "/order_bl_c.csv");
+
+    return 0;
+}
@@ -0,0 +1,49 @@
+#include "dg_test.hpp"
+
+#include "schemes/dg.hpp"
+#include "solver/solver_mpi.hpp"
+
+using namespace flux;               // NOLINT
+using flux::solver_mpi::RK3Solver;  // NOLINT
+
+int main(int argc, char **argv) {
+    auto env = solver_mpi::Environment{argc, argv};
+    if (env.rank() != 0) std::cout.setstate(std::ios::failbit);
+    std::cout << "ranks: " << env.size() << '\n';
+
+    size_t DG_k = 2;
+    size_t gauss_k = 7;
+    auto cig_o = order_test_config();
+    cig_o.gauss_k = gauss_k;
+    auto cfg_p = plot_config();
+    cfg_p.gauss_k = gauss_k;
+
+    // no limiter
+
+    auto solver1 = RK3Solver<schemes::DG>{schemes::DG{DG_k, gauss_k}};
+    DG_order_test(cig_o, solver1, DG_k,
+                  env.root_only(OUTPUT_DIR "/order_1_m.csv"));
+    DG_plot_test(cfg_p, solver1, DG_k,
+                 {env.root_only(OUTPUT_DIR "/plot_11_m.csv"),
+                  env.root_only(OUTPUT_DIR "/plot_12_m.csv")});
+
+    // with limiter, the neighbouring cell means come from the ghost cells
+
+    auto solver2 = RK3Solver<schemes::DG>{
+        schemes::DG{DG_k, gauss_k}.set_limiter(0)};
+    DG_order_test(cig_o, solver2, DG_k,
+                  env.root_only(OUTPUT_DIR "/order_2_m.csv"));
+    DG_plot_test(cfg_p, solver2, DG_k,
+                 {env.root_only(OUTPUT_DIR "/plot_21_m.csv"),
+                  env.root_only(OUTPUT_DIR "/plot_22_m.csv")});
+
+    auto solver3 = RK3Solver<schemes::DG>{
+        schemes::DG{DG_k, gauss_k}.set_limiter(1.0)};
+    DG_order_test(cig_o, solver3, DG_k,
+                  env.root_only(OUTPUT_DIR "/order_3_m.csv"));
+    DG_plot_test(cfg_p, solver3, DG_k,
+                 {env.root_only(OUTPUT_DIR "/plot_31_m.csv"),
+                  env.root_only(OUTPUT_DIR "/plot_32_m.csv")});
+
+    return 0;
+}
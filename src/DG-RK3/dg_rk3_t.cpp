@@ -0,0 +1,40 @@
+#include "dg_test.hpp"
+
+#include "schemes/dg.hpp"
+#include "solver/solver_threads.hpp"
+
+using namespace flux;                   // NOLINT
+using flux::solver_threads::RK3Solver;  // NOLINT
+
+int main() {
+    size_t DG_k = 2;
+    size_t gauss_k = 7;
+    auto cig_o = order_test_config();
+    cig_o.gauss_k = gauss_k;
+    auto cfg_p = plot_config();
+    cfg_p.gauss_k = gauss_k;
+
+    // no limiter
+
+    auto solver1 = RK3Solver<schemes::DG>{schemes::DG{DG_k, gauss_k}};
+    std::cout << "threads: " << solver1.threads() << '\n';
+    DG_order_test(cig_o, solver1, DG_k, OUTPUT_DIR "/order_1_t.csv");
+    DG_plot_test(cfg_p, solver1, DG_k,
+                 {OUTPUT_DIR "/plot_11_t.csv", OUTPUT_DIR "/plot_12_t.csv"});
+
+    // with limiter, the neighbouring cell means come from the ghost cells
+
+    auto solver2 = RK3Solver<schemes::DG>{
+        schemes::DG{DG_k, gauss_k}.set_limiter(0)};
+    DG_order_test(cig_o, solver2, DG_k, OUTPUT_DIR "/order_2_t.csv");
+    DG_plot_test(cfg_p, solver2, DG_k,
+                 {OUTPUT_DIR "/plot_21_t.csv", OUTPUT_DIR "/plot_22_t.csv"});
+
+    auto solver3 = RK3Solver<schemes::DG>{
+        schemes::DG{DG_k, gauss_k}.set_limiter(1.0)};
+    DG_order_test(cig_o, solver3, DG_k, OUTPUT_DIR "/order_3_t.csv");
+    DG_plot_test(cfg_p, solver3, DG_k,
+                 {OUTPUT_DIR "/plot_31_t.csv", OUTPUT_DIR "/plot_32_t.csv"});
+
+    return 0;
+}
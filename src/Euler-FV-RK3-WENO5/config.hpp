@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cmath>
+#include <functional>
+#include <vector>
+
+#include "constants.hpp"
+#include "euler.hpp"
+
+using namespace flux;      // NOLINT
+using flux::constant::pi;  // NOLINT
+
+struct Config {
+    double xl;
+    double xr;
+    double tend;
+    size_t gauss_k;
+    std::vector<size_t> nlist;
+
+    std::function<euler::Primitive(double)> init;
+    std::function<euler::Primitive(double, double)> exact;  // may be empty
+};
+
+// density wave carried by a constant flow, rho(x, t) = rho(x - t, 0)
+inline auto density_wave_config() {
+    auto w0 = [](double x) {
+        return euler::Primitive{1 + 0.2 * std::sin(x), 1.0, 1.0};
+    };
+    return Config{
+        .xl = -pi,
+        .xr = pi,
+        .tend = 1.0,
+        .gauss_k = 5,
+        .nlist = {10, 20, 40, 80, 160, 320},
+        .init = w0,
+        .exact = [=](double x, double t) { return w0(x - t); },
+    };
+}
+
+// two Sod shock tubes on the periodic grid, stopped before the waves of
+// neighbouring tubes meet
+inline auto shock_tube_config() {
+    return Config{
+        .xl = -pi,
+        .xr = pi,
+        .tend = 0.6,
+        .gauss_k = 5,
+        .nlist = {200},
+        .init =
+            [](double x) {
+                if (std::abs(x) < pi / 2) return euler::Primitive{1, 0, 1};
+                return euler::Primitive{0.125, 0, 0.1};
+            },
+        .exact = nullptr,
+    };
+}
@@ -0,0 +1,66 @@
+#include "euler_test.hpp"
+#include "schemes/euler_fv_weno5.hpp"
+#include "solver/solver_crtp.hpp"
+
+using namespace flux;                // NOLINT
+using flux::solver_crtp::RK3Solver;  // NOLINT
+
+// layout and Riemann solver are resolved at compile time
+template <Layout L, euler::RiemannSolver R>
+class SystemSolver
+    : public RK3Solver<SystemVec<3, L>, Mesh1d, SystemSolver<L, R>> {
+public:
+    explicit SystemSolver(bool characteristic)
+        : m_scheme{characteristic} {}
+
+    double get_dt(const SystemVec<3, L> &var, Mesh1d &ex, double t) const {
+        return m_scheme.get_dt(var, ex, t);
+    }
+
+    SystemVec<3, L> op_L(const SystemVec<3, L> &var, Mesh1d &ex,
+                         double t) const {
+        return m_scheme.op_L(var, ex, t);
+    }
+
+    auto cache_key() const { return std::tie(m_scheme); }
+
+private:
+    schemes::EulerFVWENO5<L, R> m_scheme;
+};
+
+using AoS = SystemVec<3, Layout::AoS>;
+using SoA = SystemVec<3, Layout::SoA>;
+
+int main() {
+    using euler::HLLC;
+    using euler::Rusanov;
+
+    std::cout << "SoA, HLLC, characteristic\n";
+    Euler_order_test<SoA>(density_wave_config(),
+                          SystemSolver<Layout::SoA, HLLC>{true},
+                          OUTPUT_DIR "/order_soa_hllc_c.csv");
+
+    std::cout << "AoS, HLLC, characteristic\n";
+    Euler_order_test<AoS>(density_wave_config(),
+                          SystemSolver<Layout::AoS, HLLC>{true},
+                          OUTPUT_DIR "/order_aos_hllc_c.csv");
+
+    std::cout << "SoA, Rusanov, characteristic\n";
+    Euler_order_test<SoA>(density_wave_config(),
+                          SystemSolver<Layout::SoA, Rusanov>{true},
+                          OUTPUT_DIR "/order_soa_rusanov_c.csv");
+
+    std::cout << "SoA, HLLC, component-wise\n";
+    Euler_order_test<SoA>(density_wave_config(),
+                          SystemSolver<Layout::SoA, HLLC>{false},
+                          OUTPUT_DIR "/order_soa_hllc_comp_c.csv");
+
+    Euler_plot_test<SoA>(shock_tube_config(),
+                         SystemSolver<Layout::SoA, HLLC>{true},
+                         {OUTPUT_DIR "/plot_char_c.csv"});
+    Euler_plot_test<SoA>(shock_tube_config(),
+                         SystemSolver<Layout::SoA, HLLC>{false},
+                         {OUTPUT_DIR "/plot_comp_c.csv"});
+
+    return 0;
+}
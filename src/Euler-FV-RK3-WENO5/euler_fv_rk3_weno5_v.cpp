@@ -0,0 +1,31 @@
+#include "euler_test.hpp"
+#include "schemes/euler_fv_weno5.hpp"
+#include "solver/solver_virtual.hpp"
+
+using namespace flux;                   // NOLINT
+using flux::solver_virtual::RK3Solver;  // NOLINT
+
+using AoS = SystemVec<3, Layout::AoS>;
+
+class SystemSolver : public RK3Solver<AoS, Mesh1d> {
+public:
+    double get_dt(const AoS &var, Mesh1d &ex, double t) const override {
+        return m_scheme.get_dt(var, ex, t);
+    }
+
+    AoS op_L(const AoS &var, Mesh1d &ex, double t) const override {
+        return m_scheme.op_L(var, ex, t);
+    }
+
+private:
+    schemes::EulerFVWENO5<Layout::AoS, euler::HLLC> m_scheme{};
+};
+
+int main() {
+    Euler_order_test<AoS>(density_wave_config(), SystemSolver{},
+                          OUTPUT_DIR "/order_aos_hllc_v.csv");
+    Euler_plot_test<AoS>(shock_tube_config(), SystemSolver{},
+                         {OUTPUT_DIR "/plot_char_v.csv"});
+
+    return 0;
+}
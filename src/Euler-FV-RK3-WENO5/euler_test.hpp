@@ -0,0 +1,107 @@
+#include "config.hpp"
+#include "linespace.hpp"
+
+#include "error_and_order.hpp"
+#include "export_to_file.hpp"
+
+#include "solver/preset.hpp"
+#include "solver/result_cache.hpp"
+#include "system_vec.hpp"
+
+#include "gaussquad/gaussquad.hpp"
+
+using namespace flux;  // NOLINT
+
+// cell averages of the conserved variables of w(x)
+template <typename VarType, typename Func>
+VarType Euler_project(const Func &w, const std::vector<double> &x, double dx,
+                      const gaussquad::Quad &g) {
+    size_t n = x.size();
+    auto result = VarType(std::vector<double>(3 * n));
+    for (size_t j = 0; j < n; j++) {
+        for (size_t c = 0; c < 3; c++) {
+            double tmp = g.integrate([&](double s) {
+                return euler::conserved(w(x[j] + s * dx / 2))[c];
+            }) * dx / 2;
+            result.at(j, c) = tmp / dx;
+        }
+    }
+    return result;
+}
+
+// x, rho, u, p of the cell averages
+template <typename VarType, typename SolverType>
+void Euler_plot_test(Config cfg, SolverType solver,
+                     const std::vector<const char *> &filelist) {
+    double dx = 0;
+
+    auto g = gaussquad::Quad(
+        gaussquad::gausslegendre(static_cast<unsigned>(cfg.gauss_k)));
+
+    for (size_t i = 0; i < cfg.nlist.size(); i++) {
+        size_t n = cfg.nlist[i];
+        auto x = linespace_mid(cfg.xl, cfg.xr, n, dx);
+        auto uh = Euler_project<VarType>(cfg.init, x, dx, g);
+
+        auto ex = Mesh1d{dx};
+        uh = cached_run(solver, uh, ex, 0, cfg.tend, filelist[i]).value();
+
+        auto rho = std::vector<double>(n);
+        auto u = std::vector<double>(n);
+        auto p = std::vector<double>(n);
+        for (size_t j = 0; j < n; j++) {
+            auto w = euler::primitive(uh.get(j));
+            rho[j] = w.rho;
+            u[j] = w.u;
+            p[j] = w.p;
+        }
+
+        export_to_file(filelist[i], x, rho, u, p, ',');
+    }
+}
+
+// errors of the density
+template <typename VarType, typename SolverType>
+void Euler_order_test(Config cfg, SolverType solver, const char *filename) {
+    double dx = 0;
+
+    auto exact = [=](double x) { return cfg.exact(x, cfg.tend); };
+
+    auto g = gaussquad::Quad(
+        gaussquad::gausslegendre(static_cast<unsigned>(cfg.gauss_k)));
+
+    auto error_l1 = std::vector<double>(cfg.nlist.size());
+    auto error_l2 = std::vector<double>(cfg.nlist.size());
+    auto error_linf = std::vector<double>(cfg.nlist.size());
+
+    for (size_t i = 0; i < cfg.nlist.size(); i++) {
+        size_t n = cfg.nlist[i];
+        auto x = linespace_mid(cfg.xl, cfg.xr, n, dx);
+        auto uh = Euler_project<VarType>(cfg.init, x, dx, g);
+
+        auto ex = Mesh1d{dx};
+        uh = cached_run(solver, uh, ex, 0, cfg.tend, filename).value();
+        auto u = Euler_project<VarType>(exact, x, dx, g);
+
+        auto rho_h = std::vector<double>(n);
+        auto rho = std::vector<double>(n);
+        for (size_t j = 0; j < n; j++) {
+            rho_h[j] = uh.at(j, 0);
+            rho[j] = u.at(j, 0);
+        }
+
+        auto errs = error_norms(rho_h, rho, dx);
+        error_l1[i] = errs.l1;
+        error_l2[i] = errs.l2;
+        error_linf[i] = errs.linf;
+    }
+
+    auto order_l1 = order(error_l1, cfg.nlist);
+    auto order_l2 = order(error_l2, cfg.nlist);
+    auto order_linf = order(error_linf, cfg.nlist);
+
+    print_error_table(std::cout, cfg.nlist, error_l1, error_l2, error_linf,
+                      order_l1, order_l2, order_linf, ' ');
+    print_error_table_to_file(filename, cfg.nlist, error_l1, error_l2,
+                              error_linf, order_l1, order_l2, order_linf, '&');
+}
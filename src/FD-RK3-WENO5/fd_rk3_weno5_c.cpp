@@ -1,60 +1,24 @@
 #include "fd_test.hpp"
-#include "period_index.hpp"
+#include "schemes/fd_weno5.hpp"
 #include "solver/solver_crtp.hpp"
-#include "weno5.hpp"
 
 using namespace flux;  // NOLINT
 using flux::solver_crtp::RK3Solver;
 
 class FDWENO5Solver : public RK3Solver<Vec, Mesh1d, FDWENO5Solver> {
 public:
-    static double get_dt(const Vec &var, Mesh1d &ex, double t) {
-        double df_max = 0;
-        for (const auto ui : var.data) {
-            double tmp = std::abs(ui);  // df(u) = u
-            if (tmp > df_max) df_max = tmp;
-        }
-        return std::pow(ex.dx, 5.0 / 3) / (2 * df_max);
+    double get_dt(const Vec &var, Mesh1d &ex, double t) const {
+        return m_scheme.get_dt(var, ex, t);
     }
 
-    static Vec op_L(const Vec &var, Mesh1d &ex, double t) {
-        const auto &u = var.data;
-        size_t n = u.size();
-        auto L = std::vector<double>(n);
-
-        double lf_c{0};  // gobal c
-        for (size_t i = 0; i < n; i++) {
-            double lf_c_tmp = std::abs(u[i]);
-            lf_c = (lf_c_tmp > lf_c) ? lf_c_tmp : lf_c;
-        }
-
-        // split
-        auto fplus = [lf_c](double v) { return 0.5 * (v * v / 2 + lf_c * v); };
-        auto fminus = [lf_c](double v) { return 0.5 * (v * v / 2 - lf_c * v); };
-        auto fu_plus = std::vector<double>(n);
-        auto fu_minus = std::vector<double>(n);
-
-        for (size_t i = 0; i < n; i++) {
-            fu_plus[i] = fplus(u[i]);
-            fu_minus[i] = fminus(u[i]);
-        }
-
-        auto fplus_r = std::vector<double>(n);
-        auto fplus_l_useless = std::vector<double>(n);   // useless
-        auto fminus_r_useless = std::vector<double>(n);  // useless
-        auto fminus_l = std::vector<double>(n);
+    Vec op_L(const Vec &var, Mesh1d &ex, double t) const {
+        return m_scheme.op_L(var, ex, t);
+    }
 
-        weno5(fu_plus, fplus_l_useless, fplus_r);
-        weno5(fu_minus, fminus_l, fminus_r_useless);
+    auto cache_key() const { return std::tie(m_scheme); }
 
-        for (size_t i = 0; i < n; i++) {
-            auto idx = PeriodIndex(n, i);
-            double fhat_l = fplus_r[idx.l()] + fminus_l[idx.c()];
-            double fhat_r = fplus_r[idx.c()] + fminus_l[idx.r()];
-            L[i] = (fhat_l - fhat_r) / ex.dx;
-        }
-        return Vec{L};
-    }
+private:
+    schemes::FDWENO5 m_scheme{};
 };
 
 int main() {
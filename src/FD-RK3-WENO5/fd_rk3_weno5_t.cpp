@@ -0,0 +1,17 @@
+#include "fd_test.hpp"
+#include "schemes/fd_weno5.hpp"
+#include "solver/solver_threads.hpp"
+
+using namespace flux;                   // NOLINT
+using flux::solver_threads::RK3Solver;  // NOLINT
+
+int main() {
+    auto solver = RK3Solver<schemes::FDWENO5>{schemes::FDWENO5{}};
+    std::cout << "threads: " << solver.threads() << '\n';
+
+    FD_order_test(order_test_config(), solver, OUTPUT_DIR "/order_t.csv");
+    FD_plot_test(plot_config(), solver,
+                 {OUTPUT_DIR "/plot_1_t.csv", OUTPUT_DIR "/plot_2_t.csv"});
+
+    return 0;
+}
@@ -5,11 +5,12 @@
 #include "export_to_file.hpp"
 
 #include "solver/preset.hpp"
+#include "solver/result_cache.hpp"
 
 using namespace flux;  // NOLINT
 
-template <typename SolverType>
-void FD_plot_test(Config cfg, SolverType solver,
+template <typename Init, typename Exact, typename SolverType>
+void FD_plot_test(const Config<Init, Exact> &cfg, SolverType solver,
                   const std::vector<const char *> &filelist) {
     double dx = 0;
 
@@ -21,7 +22,9 @@ void FD_plot_test(Config cfg, SolverType solver,
         for (size_t j = 0; j < n; j++) { uh[j] = cfg.init(x[j]); }
 
         auto ex = Mesh1d{dx};
-        uh = solver.run(Vec{uh}, ex, 0, cfg.tend).value().data;
+        uh = cached_run(solver, Vec{uh}, ex, 0, cfg.tend, filelist[i])
+              .value()
+              .data;
 
         auto u = std::vector<double>(n);
         for (size_t j = 0; j < n; j++) { u[j] = cfg.exact(x[j], cfg.tend); }
@@ -30,8 +33,9 @@ void FD_plot_test(Config cfg, SolverType solver,
     }
 }
 
-template <typename SolverType>
-void FD_order_test(Config cfg, SolverType solver, const char *filename) {
+template <typename Init, typename Exact, typename SolverType>
+void FD_order_test(const Config<Init, Exact> &cfg, SolverType solver,
+                   const char *filename) {
     double dx = 0;
 
     auto error_l1 = std::vector<double>(cfg.nlist.size());
@@ -46,14 +50,17 @@ void FD_order_test(Config cfg, SolverType solver, const char *filename) {
         for (size_t j = 0; j < n; j++) { uh[j] = cfg.init(x[j]); }
 
         auto ex = Mesh1d{dx};
-        uh = solver.run(Vec{uh}, ex, 0, cfg.tend).value().data;
+        uh = cached_run(solver, Vec{uh}, ex, 0, cfg.tend, filename)
+              .value()
+              .data;
 
         auto u = std::vector<double>(n);
         for (size_t j = 0; j < n; j++) { u[j] = cfg.exact(x[j], cfg.tend); }
 
-        error_l1[i] = error(uh, u, dx, ErrorType::L1);
-        error_l2[i] = error(uh, u, dx, ErrorType::L2);
-        error_linf[i] = error(uh, u, dx, ErrorType::Linf);
+        auto errs = error_norms(uh, u, dx);
+        error_l1[i] = errs.l1;
+        error_l2[i] = errs.l2;
+        error_linf[i] = errs.linf;
     }
 
     auto order_l1 = order(error_l1, cfg.nlist);
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <vector>
+
+#include "burgers_exact.hpp"
+#include "constants.hpp"
+
+using namespace flux;      // NOLINT
+using flux::constant::pi;  // NOLINT
+
+// u(x, y, t) = v(x + y, 2t), where v solves the 1d problem v_t + (v^2/2)_x = 0;
+// init(x, y) and exact(x, y, t) are template parameters, so the cell
+// averages inline them
+template <typename Init, typename Exact>
+struct Config {
+    double xl;
+    double xr;
+    double yl;
+    double yr;
+    double tend;
+    size_t gauss_k;
+    std::vector<size_t> nlist;
+
+    Init init;
+    Exact exact;
+};
+
+inline auto plot_config() {
+    return Config{
+        .xl = -pi,
+        .xr = pi,
+        .yl = -pi,
+        .yr = pi,
+        .tend = 0.75,
+        .gauss_k = 5,
+        .nlist = {20, 80},
+        .init =
+            [](double x, double y) {
+                return BurgersExact(0.5, 1.0, 1.0, 0, 1e-10).eval(x + y, 0);
+            },
+        .exact =
+            [](double x, double y, double t) {
+                return BurgersExact(0.5, 1.0, 1.0, 0, 1e-10)
+                    .eval(x + y, 2 * t);
+            },
+    };
+}
+
+inline auto order_test_config() {
+    return Config{
+        .xl = -pi,
+        .xr = pi,
+        .yl = -pi,
+        .yr = pi,
+        .tend = 0.25,
+        .gauss_k = 5,
+        .nlist = {10, 20, 40, 80, 160},
+        .init =
+            [](double x, double y) {
+                return BurgersExact(0.5, 1.0, 1.0, 0, 1e-10).eval(x + y, 0);
+            },
+        .exact =
+            [](double x, double y, double t) {
+                return BurgersExact(0.5, 1.0, 1.0, 0, 1e-10)
+                    .eval_with_check(x + y, 2 * t);
+            },
+    };
+}
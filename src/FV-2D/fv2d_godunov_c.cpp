@@ -0,0 +1,33 @@
+#include "fv2d_test.hpp"
+#include "schemes/fv2d_godunov.hpp"
+#include "solver/solver_crtp.hpp"
+
+using namespace flux;                  // NOLINT
+using flux::solver_crtp::EulerSolver;  // NOLINT
+
+class FV2dGodunovSolver : public EulerSolver<Vec, Mesh2d, FV2dGodunovSolver> {
+public:
+    double get_dt(const Vec &var, Mesh2d &ex, double t) const {
+        return m_scheme.get_dt(var, ex, t);
+    }
+
+    Vec op_L(const Vec &var, Mesh2d &ex, double t) const {
+        return m_scheme.op_L(var, ex, t);
+    }
+
+    auto cache_key() const { return std::tie(m_scheme); }
+
+private:
+    schemes::FV2dGodunov m_scheme{};
+};
+
+int main() {
+    auto solver = FV2dGodunovSolver{};
+    FV2d_order_test(order_test_config(), solver,
+                    OUTPUT_DIR "/godunov_order_c.csv");
+    FV2d_plot_test(plot_config(), solver,
+                   {OUTPUT_DIR "/godunov_plot_1_c.csv",
+                    OUTPUT_DIR "/godunov_plot_2_c.csv"});
+
+    return 0;
+}
@@ -0,0 +1,21 @@
+#include "fv2d_test.hpp"
+#include "schemes/fv2d_godunov.hpp"
+#include "solver/solver_mpi.hpp"
+
+using namespace flux;                 // NOLINT
+using flux::solver_mpi::EulerSolver;  // NOLINT
+
+int main(int argc, char **argv) {
+    auto env = solver_mpi::Environment{argc, argv};
+    if (env.rank() != 0) std::cout.setstate(std::ios::failbit);
+    std::cout << "ranks: " << env.size() << '\n';
+
+    auto solver = EulerSolver<schemes::FV2dGodunov>{schemes::FV2dGodunov{}};
+    FV2d_order_test(order_test_config(), solver,
+                    env.root_only(OUTPUT_DIR "/godunov_order_m.csv"));
+    FV2d_plot_test(plot_config(), solver,
+                   {env.root_only(OUTPUT_DIR "/godunov_plot_1_m.csv"),
+                    env.root_only(OUTPUT_DIR "/godunov_plot_2_m.csv")});
+
+    return 0;
+}
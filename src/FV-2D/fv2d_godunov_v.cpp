@@ -0,0 +1,31 @@
+#include "fv2d_test.hpp"
+#include "schemes/fv2d_godunov.hpp"
+#include "solver/solver_virtual.hpp"
+
+using namespace flux;                     // NOLINT
+using flux::solver_virtual::EulerSolver;  // NOLINT
+
+class FV2dGodunovSolver : public EulerSolver<Vec, Mesh2d> {
+public:
+    double get_dt(const Vec &var, Mesh2d &ex, double t) const override {
+        return m_scheme.get_dt(var, ex, t);
+    }
+
+    Vec op_L(const Vec &var, Mesh2d &ex, double t) const override {
+        return m_scheme.op_L(var, ex, t);
+    }
+
+private:
+    schemes::FV2dGodunov m_scheme{};
+};
+
+int main() {
+    auto solver = FV2dGodunovSolver{};
+    FV2d_order_test(order_test_config(), solver,
+                    OUTPUT_DIR "/godunov_order_v.csv");
+    FV2d_plot_test(plot_config(), solver,
+                   {OUTPUT_DIR "/godunov_plot_1_v.csv",
+                    OUTPUT_DIR "/godunov_plot_2_v.csv"});
+
+    return 0;
+}
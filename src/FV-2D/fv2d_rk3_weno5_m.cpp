@@ -0,0 +1,21 @@
+#include "fv2d_test.hpp"
+#include "schemes/fv2d_weno5.hpp"
+#include "solver/solver_mpi.hpp"
+
+using namespace flux;               // NOLINT
+using flux::solver_mpi::RK3Solver;  // NOLINT
+
+int main(int argc, char **argv) {
+    auto env = solver_mpi::Environment{argc, argv};
+    if (env.rank() != 0) std::cout.setstate(std::ios::failbit);
+    std::cout << "ranks: " << env.size() << '\n';
+
+    auto solver = RK3Solver<schemes::FV2dWENO5>{schemes::FV2dWENO5{}};
+    FV2d_order_test(order_test_config(), solver,
+                    env.root_only(OUTPUT_DIR "/weno5_order_m.csv"));
+    FV2d_plot_test(plot_config(), solver,
+                   {env.root_only(OUTPUT_DIR "/weno5_plot_1_m.csv"),
+                    env.root_only(OUTPUT_DIR "/weno5_plot_2_m.csv")});
+
+    return 0;
+}
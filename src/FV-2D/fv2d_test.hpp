@@ -0,0 +1,115 @@
+#include "config.hpp"
+#include "linespace.hpp"
+
+#include "error_and_order.hpp"
+#include "export_to_file.hpp"
+
+#include "solver/preset.hpp"
+#include "solver/result_cache.hpp"
+
+#include "gaussquad/gaussquad.hpp"
+
+using namespace flux;  // NOLINT
+
+// cell averages of func on the nx * ny cells, row-major
+template <typename Func>
+std::vector<double> cell_average(const gaussquad::Quad &g,
+                                 const std::vector<double> &x,
+                                 const std::vector<double> &y, double dx,
+                                 double dy, Func func) {
+    size_t nx = x.size();
+    size_t ny = y.size();
+    auto result = std::vector<double>(nx * ny);
+    for (size_t j = 0; j < ny; j++) {
+        for (size_t i = 0; i < nx; i++) {
+            double tmp = g.integrate([&](double s) {
+                return g.integrate([&](double r) {
+                    return func(x[i] + s * dx / 2, y[j] + r * dy / 2);
+                });
+            });
+            result[j * nx + i] = tmp / 4;
+        }
+    }
+    return result;
+}
+
+template <typename Init, typename Exact, typename SolverType>
+void FV2d_plot_test(const Config<Init, Exact> &cfg, SolverType solver,
+                    const std::vector<const char *> &filelist) {
+    double dx = 0;
+    double dy = 0;
+
+    auto exact = [&](double x, double y) { return cfg.exact(x, y, cfg.tend); };
+
+    auto g = gaussquad::Quad(
+        gaussquad::gausslegendre(static_cast<unsigned>(cfg.gauss_k)));
+
+    for (size_t i = 0; i < cfg.nlist.size(); i++) {
+        size_t n = cfg.nlist[i];
+        auto x = linespace_mid(cfg.xl, cfg.xr, n, dx);
+        auto y = linespace_mid(cfg.yl, cfg.yr, n, dy);
+
+        auto uh = cell_average(g, x, y, dx, dy, cfg.init);
+
+        auto ex = Mesh2d{dx, dy, n, n};
+        uh = cached_run(solver, Vec{uh}, ex, 0, cfg.tend, filelist[i])
+              .value()
+              .data;
+
+        auto u = cell_average(g, x, y, dx, dy, exact);
+
+        auto xx = std::vector<double>(n * n);
+        auto yy = std::vector<double>(n * n);
+        for (size_t j = 0; j < n * n; j++) {
+            xx[j] = x[j % n];
+            yy[j] = y[j / n];
+        }
+
+        export_to_file(filelist[i], xx, yy, u, uh, ',');
+    }
+}
+
+template <typename Init, typename Exact, typename SolverType>
+void FV2d_order_test(const Config<Init, Exact> &cfg, SolverType solver,
+                     const char *filename) {
+    double dx = 0;
+    double dy = 0;
+
+    auto exact = [&](double x, double y) { return cfg.exact(x, y, cfg.tend); };
+
+    auto g = gaussquad::Quad(
+        gaussquad::gausslegendre(static_cast<unsigned>(cfg.gauss_k)));
+
+    auto error_l1 = std::vector<double>(cfg.nlist.size());
+    auto error_l2 = std::vector<double>(cfg.nlist.size());
+    auto error_linf = std::vector<double>(cfg.nlist.size());
+
+    for (size_t i = 0; i < cfg.nlist.size(); i++) {
+        size_t n = cfg.nlist[i];
+        auto x = linespace_mid(cfg.xl, cfg.xr, n, dx);
+        auto y = linespace_mid(cfg.yl, cfg.yr, n, dy);
+
+        auto uh = cell_average(g, x, y, dx, dy, cfg.init);
+
+        auto ex = Mesh2d{dx, dy, n, n};
+        uh = cached_run(solver, Vec{uh}, ex, 0, cfg.tend, filename)
+              .value()
+              .data;
+
+        auto u = cell_average(g, x, y, dx, dy, exact);
+
+        auto errs = error_norms(uh, u, dx * dy);
+        error_l1[i] = errs.l1;
+        error_l2[i] = errs.l2;
+        error_linf[i] = errs.linf;
+    }
+
+    auto order_l1 = order(error_l1, cfg.nlist);
+    auto order_l2 = order(error_l2, cfg.nlist);
+    auto order_linf = order(error_linf, cfg.nlist);
+
+    print_error_table(std::cout, cfg.nlist, error_l1, error_l2, error_linf,
+                      order_l1, order_l2, order_linf, ' ');
+    print_error_table_to_file(filename, cfg.nlist, error_l1, error_l2,
+                              error_linf, order_l1, order_l2, order_linf, '&');
+}
@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "config.hpp"
+
+#include "amr/grid.hpp"
+#include "export_to_file.hpp"
+
+#include "gaussquad/gaussquad.hpp"
+
+using namespace flux;  // NOLINT
+
+struct AMRResult {
+    size_t cells;
+    double error_l1;
+    double error_linf;
+    double mass_error;  // |integral of u at tend - integral at 0|
+    double seconds;
+    size_t cell_updates;  // cell steps of the solver
+};
+
+// run on a grid of root_blocks blocks refined up to max_level, the initial
+// data is projected again after each initial regrid pass
+template <typename SolverType>
+AMRResult AMR_run(Config cfg, const SolverType &solver, size_t root_blocks,
+                  size_t max_level, const char *plot_file) {
+    auto g = gaussquad::Quad(
+        gaussquad::gausslegendre(static_cast<unsigned>(cfg.gauss_k)));
+    auto average = [&](const auto &func) {
+        return [&g, func](double a, double b) {
+            return g.integrate([&](double s) {
+                return func((a + b) / 2 + s * (b - a) / 2);
+            }) / 2;
+        };
+    };
+    auto exact = [=](double x) { return cfg.exact(x, cfg.tend); };
+
+    auto grid = amr::Grid(cfg.xl, cfg.xr, root_blocks, cfg.block,
+                          SolverType::halo, max_level);
+    grid.project(average(cfg.init));
+    for (size_t l = 0; l < max_level; l++) {
+        solver.adapt(grid);
+        grid.project(average(cfg.init));
+    }
+
+    auto integral = [](const amr::Grid &mesh) {
+        auto u = mesh.values();
+        auto dx = mesh.widths();
+        double sum = 0;
+        for (size_t i = 0; i < u.size(); i++) sum += u[i] * dx[i];
+        return sum;
+    };
+    double mass = integral(grid);
+
+    size_t cell_updates = 0;
+    auto start = std::chrono::steady_clock::now();
+    grid = solver.run(std::move(grid), 0, cfg.tend, cell_updates).value();
+    auto stop = std::chrono::steady_clock::now();
+
+    mass -= integral(grid);
+    auto uh = grid.values();
+    grid.project(average(exact));
+    auto u = grid.values();
+
+    auto dx = grid.widths();
+    double error_l1 = 0;
+    double error_linf = 0;
+    for (size_t i = 0; i < u.size(); i++) {
+        double tmp = std::abs(uh[i] - u[i]);
+        error_l1 += tmp * dx[i];
+        error_linf = std::max(error_linf, tmp);
+    }
+
+    export_to_file(plot_file, grid.centers(), u, uh, grid.levels(), ',');
+
+    return {grid.cells(), error_l1, error_linf, std::abs(mass),
+            std::chrono::duration<double>(stop - start).count(),
+            cell_updates};
+}
+
+// AMR with max_level l against the uniform grid of its finest cell width
+template <typename SolverType>
+void AMR_test(Config cfg, const SolverType &solver, const std::string &prefix) {
+    std::string filename = prefix + "_table.csv";
+    std::fstream f(filename, std::ios::out);
+    if (f.fail()) {
+        std::cerr << "AMR_test: fail to open file " << filename << std::endl;
+        exit(1);
+    }
+    f << "max_level,cells,uniform_cells,error_1,uniform_error_1,error_inf,"
+         "uniform_error_inf,seconds,uniform_seconds\n";
+
+    std::printf("%5s %8s %8s %12s %12s %10s %10s\n", "level", "cells",
+                "uniform", "error_1", "uniform_e1", "time", "uniform_t");
+    for (auto l : cfg.levels) {
+        auto plot = prefix + "_plot_" + std::to_string(l) + ".csv";
+        auto a = AMR_run(cfg, solver, cfg.root_blocks, l, plot.c_str());
+        auto b = AMR_run(cfg, solver, cfg.root_blocks << l, 0, "");
+
+        std::printf("%5zu %8zu %8zu %12.4e %12.4e %10.4f %10.4f\n", l,
+                    a.cells, b.cells, a.error_l1, b.error_l1, a.seconds,
+                    b.seconds);
+        f << l << ',' << a.cells << ',' << b.cells << ',' << a.error_l1 << ','
+          << b.error_l1 << ',' << a.error_linf << ',' << b.error_linf << ','
+          << a.seconds << ',' << b.seconds << '\n';
+    }
+    std::cout << "export to file " << filename << '\n';
+}
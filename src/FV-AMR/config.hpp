@@ -0,0 +1,48 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "amr/grid.hpp"
+#include "burgers_exact.hpp"
+#include "constants.hpp"
+
+using namespace flux;      // NOLINT
+using flux::constant::pi;  // NOLINT
+
+// the plot_config() problem of the 1d examples, the shock forms at t = 1
+struct Config {
+    double xl;
+    double xr;
+    double tend;
+    size_t gauss_k;
+
+    size_t block;                // cells per block
+    size_t root_blocks;          // blocks of the level 0 grid
+    std::vector<size_t> levels;  // max_level of each run
+    amr::RegridConfig regrid;
+
+    std::function<double(double)> init;
+    std::function<double(double, double)> exact;
+};
+
+inline auto amr_config() {
+    return Config{
+        .xl = -pi,
+        .xr = pi,
+        .tend = 1.5,
+        .gauss_k = 5,
+        .block = 8,
+        .root_blocks = 10,
+        .levels = {0, 1, 2, 3, 4},
+        .regrid = {.interval = 4, .refine_tol = 0.1, .coarsen_tol = 0.02},
+        .init =
+            [](double x) {
+                return BurgersExact(0.5, 1.0, 1.0, 0, 1e-10).eval(x, 0);
+            },
+        .exact =
+            [](double x, double t) {
+                return BurgersExact(0.5, 1.0, 1.0, 0, 1e-10).eval(x, t);
+            },
+    };
+}
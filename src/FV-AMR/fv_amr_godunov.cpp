@@ -0,0 +1,18 @@
+#include "amr_test.hpp"
+#include "schemes/fv_godunov.hpp"
+#include "solver/solver_amr.hpp"
+
+using namespace flux;                 // NOLINT
+using flux::solver_amr::EulerSolver;  // NOLINT
+
+int main() {
+    auto cfg = amr_config();
+    // first order: the error of the smooth regions dominates, refine them too
+    cfg.regrid.refine_tol = 0.02;
+    cfg.regrid.coarsen_tol = 0.005;
+
+    auto solver = EulerSolver<schemes::FVGodunov>{schemes::FVGodunov{}, cfg.regrid};
+    AMR_test(cfg, solver, OUTPUT_DIR "/godunov");
+
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include "amr_test.hpp"
+#include "schemes/fv_godunov.hpp"
+#include "schemes/fv_weno5.hpp"
+#include "solver/solver_amr.hpp"
+#include "solver/solver_lts.hpp"
+
+using namespace flux;  // NOLINT
+
+// local time stepping against the global dt of the finest level on the same
+// adaptive grids: cell steps, error, conservation and time
+template <typename Global, typename Local>
+void LTS_test(Config cfg, const Global &global, const Local &local,
+              const std::string &prefix) {
+    std::string filename = prefix + "_lts_table.csv";
+    std::fstream f(filename, std::ios::out);
+    if (f.fail()) {
+        std::cerr << "LTS_test: fail to open file " << filename << std::endl;
+        exit(1);
+    }
+    f << "max_level,cells,cell_updates,lts_cell_updates,error_1,lts_error_1,"
+         "mass_error,lts_mass_error,seconds,lts_seconds\n";
+
+    std::printf("%5s %6s %10s %10s %11s %11s %9s %9s %8s %8s\n", "level",
+                "cells", "updates", "lts_upd", "error_1", "lts_e1", "mass",
+                "lts_mass", "time", "lts_t");
+    for (auto l : cfg.levels) {
+        auto a = AMR_run(cfg, global, cfg.root_blocks, l, "");
+        auto b = AMR_run(cfg, local, cfg.root_blocks, l, "");
+        size_t gu = a.cell_updates;
+        size_t lu = b.cell_updates;
+
+        std::printf(
+            "%5zu %6zu %10zu %10zu %11.4e %11.4e %9.1e %9.1e %8.4f %8.4f\n", l,
+            b.cells, gu, lu, a.error_l1, b.error_l1, a.mass_error,
+            b.mass_error, a.seconds, b.seconds);
+        f << l << ',' << b.cells << ',' << gu << ',' << lu << ','
+          << a.error_l1 << ',' << b.error_l1 << ',' << a.mass_error << ','
+          << b.mass_error << ',' << a.seconds << ',' << b.seconds << '\n';
+    }
+    std::cout << "export to file " << filename << '\n';
+}
+
+int main() {
+    auto cfg = amr_config();
+
+    std::cout << "FV-Euler-Godunov\n";
+    auto godunov_cfg = cfg;
+    godunov_cfg.regrid.refine_tol = 0.02;
+    godunov_cfg.regrid.coarsen_tol = 0.005;
+    LTS_test(godunov_cfg,
+             solver_amr::EulerSolver<schemes::FVGodunov>{schemes::FVGodunov{},
+                                                         godunov_cfg.regrid},
+             solver_lts::EulerSolver<schemes::FVGodunov>{schemes::FVGodunov{},
+                                                         godunov_cfg.regrid},
+             OUTPUT_DIR "/godunov");
+
+    std::cout << "FV-RK3-WENO5\n";
+    LTS_test(cfg,
+             solver_amr::RK3Solver<schemes::FVWENO5>{schemes::FVWENO5{},
+                                                     cfg.regrid},
+             solver_lts::RK3Solver<schemes::FVWENO5>{schemes::FVWENO5{},
+                                                     cfg.regrid},
+             OUTPUT_DIR "/weno5");
+
+    return 0;
+}
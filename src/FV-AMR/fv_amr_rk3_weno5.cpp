@@ -0,0 +1,14 @@
+#include "amr_test.hpp"
+#include "schemes/fv_weno5.hpp"
+#include "solver/solver_amr.hpp"
+
+using namespace flux;               // NOLINT
+using flux::solver_amr::RK3Solver;  // NOLINT
+
+int main() {
+    auto cfg = amr_config();
+    auto solver = RK3Solver<schemes::FVWENO5>{schemes::FVWENO5{}, cfg.regrid};
+    AMR_test(cfg, solver, OUTPUT_DIR "/weno5");
+
+    return 0;
+}
@@ -0,0 +1,36 @@
+#include "fv_test.hpp"
+#include "schemes/fv_godunov.hpp"
+#include "solver/solver_crtp.hpp"
+
+using namespace flux;                  // NOLINT
+using flux::solver_crtp::EulerSolver;  // NOLINT
+
+// the same scheme for any flux policy F, inlined at compile time
+template <FluxPolicy F>
+class LawSolver : public EulerSolver<Vec, Mesh1d, LawSolver<F>> {
+public:
+    double get_dt(const Vec &var, Mesh1d &ex, double t) const {
+        return m_scheme.get_dt(var, ex, t);
+    }
+
+    Vec op_L(const Vec &var, Mesh1d &ex, double t) const {
+        return m_scheme.op_L(var, ex, t);
+    }
+
+    auto cache_key() const { return std::tie(m_scheme); }
+
+private:
+    schemes::BasicFVGodunov<F> m_scheme{};
+};
+
+int main() {
+    std::cout << "linear advection\n";
+    FV_order_test(linear_advection_config(), LawSolver<LinearAdvection<>>{},
+                  OUTPUT_DIR "/order_advection_c.csv");
+
+    std::cout << "Buckley-Leverett\n";
+    FV_order_test(buckley_leverett_config(), LawSolver<BuckleyLeverett<>>{},
+                  OUTPUT_DIR "/order_bl_c.csv");
+
+    return 0;
+}
@@ -1,5 +1,5 @@
 #include "fv_test.hpp"
-#include "period_index.hpp"
+#include "schemes/fv_godunov.hpp"
 #include "solver/solver_deducing.hpp"
 
 using namespace flux;  // NOLINT
@@ -7,26 +7,12 @@ using flux::solver_deducing::EulerSolver;
 
 class FVGodunovSolver : public EulerSolver<Vec, Mesh1d> {
 public:
-    static double get_dt(const Vec &var, Mesh1d &ex, double t) {
-        double df_max = 0;
-        for (const auto ui : var.data) {
-            double tmp = std::abs(ui);  // df(u) = u
-            if (tmp > df_max) df_max = tmp;
-        }
-        return 0.5 * (ex.dx) / df_max;
+    double get_dt(const Vec &var, Mesh1d &ex, double t) const {
+        return m_scheme.get_dt(var, ex, t);
     }
 
-    static Vec op_L(const Vec &var, Mesh1d &ex, double t) {
-        const auto &u = var.data;
-        size_t n = u.size();
-        auto L = std::vector<double>(n);
-        for (size_t i = 0; i < n; i++) {
-            auto idx = PeriodIndex(n, i);
-            double fhat_l = fhat_godunov(u[idx.l()], u[idx.c()]);
-            double fhat_r = fhat_godunov(u[idx.c()], u[idx.r()]);
-            L[i] = (fhat_l - fhat_r) / (ex.dx);
-        }
-        return Vec{L};
+    Vec op_L(const Vec &var, Mesh1d &ex, double t) const {
+        return m_scheme.op_L(var, ex, t);
     }
 
     static Vec post_process(const Vec &var, Mesh1d &ex, double t) {
@@ -35,13 +21,10 @@ public:
 
     static Vec pre_process(const Vec &var, Mesh1d &ex, double t) { return var; }
 
-    static double fhat_godunov(double ul, double ur) {
-        if (ul <= ur) {  // min
-            if (ul * ur > 0) { return std::min(ul * ul / 2, ur * ur / 2); }
-            return 0.0;
-        }
-        return std::max(ul * ul / 2, ur * ur / 2);  // max
-    };
+    auto cache_key() const { return std::tie(m_scheme); }
+
+private:
+    schemes::FVGodunov m_scheme{};
 };
 
 int main() {
@@ -0,0 +1,17 @@
+#include "fv_test.hpp"
+#include "schemes/fv_godunov.hpp"
+#include "solver/solver_threads.hpp"
+
+using namespace flux;                     // NOLINT
+using flux::solver_threads::EulerSolver;  // NOLINT
+
+int main() {
+    auto solver = EulerSolver<schemes::FVGodunov>{schemes::FVGodunov{}};
+    std::cout << "threads: " << solver.threads() << '\n';
+
+    FV_order_test(order_test_config(), solver, OUTPUT_DIR "/order_t.csv");
+    FV_plot_test(plot_config(), solver,
+                 {OUTPUT_DIR "/plot_1_t.csv", OUTPUT_DIR "/plot_2_t.csv"});
+
+    return 0;
+}
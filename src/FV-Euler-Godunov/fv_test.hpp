@@ -1,60 +1,44 @@
 #include "config.hpp"
 #include "linespace.hpp"
+#include "projection.hpp"
 
 #include "error_and_order.hpp"
 #include "export_to_file.hpp"
 
 #include "solver/preset.hpp"
-
-#include "gaussquad/gaussquad.hpp"
+#include "solver/result_cache.hpp"
 
 using namespace flux;  // NOLINT
 
-template <typename SolverType>
-void FV_plot_test(Config cfg, SolverType solver,
+template <typename Init, typename Exact, typename SolverType>
+void FV_plot_test(const Config<Init, Exact> &cfg, SolverType solver,
                   const std::vector<const char *> &filelist) {
     double dx = 0;
 
-    auto exact = [=](double x) { return cfg.exact(x, cfg.tend); };
-
-    auto g = gaussquad::Quad(
-        gaussquad::gausslegendre(static_cast<unsigned>(cfg.gauss_k)));
+    auto exact = [&](double x) { return cfg.exact(x, cfg.tend); };
 
     for (size_t i = 0; i < cfg.nlist.size(); i++) {
         size_t n = cfg.nlist[i];
         auto x = linespace_mid(cfg.xl, cfg.xr, n, dx);
-        auto uh = std::vector<double>(n);
-
-        for (size_t j = 0; j < n; j++) {
-            double tmp = g.integrate([=](double s) {
-                return cfg.init(x[j] + s * dx / 2);
-            }) * dx / 2;
-            uh[j] = tmp / dx;
-        }
+        auto uh = cell_averages(cfg.init, x, dx, cfg.gauss_k);
 
         auto ex = Mesh1d{dx};
-        uh = solver.run(Vec{uh}, ex, 0, cfg.tend).value().data;
+        uh = cached_run(solver, Vec{uh}, ex, 0, cfg.tend, filelist[i])
+              .value()
+              .data;
 
-        auto u = std::vector<double>(n);
-        for (size_t j = 0; j < n; j++) {
-            double tmp = g.integrate([=](double s) {
-                return exact(x[j] + s * dx / 2);
-            }) * dx / 2;
-            u[j] = tmp / dx;
-        }
+        auto u = cell_averages(exact, x, dx, cfg.gauss_k);
 
         export_to_file(filelist[i], x, u, uh, ',');
     }
 }
 
-template <typename SolverType>
-void FV_order_test(Config cfg, SolverType solver, const char *filename) {
+template <typename Init, typename Exact, typename SolverType>
+void FV_order_test(const Config<Init, Exact> &cfg, SolverType solver,
+                   const char *filename) {
     double dx = 0;
 
-    auto exact = [=](double x) { return cfg.exact(x, cfg.tend); };
-
-    auto g = gaussquad::Quad(
-        gaussquad::gausslegendre(static_cast<unsigned>(cfg.gauss_k)));
+    auto exact = [&](double x) { return cfg.exact(x, cfg.tend); };
 
     auto error_l1 = std::vector<double>(cfg.nlist.size());
     auto error_l2 = std::vector<double>(cfg.nlist.size());
@@ -63,29 +47,19 @@ void FV_order_test(Config cfg, SolverType solver, const char *filename) {
     for (size_t i = 0; i < cfg.nlist.size(); i++) {
         size_t n = cfg.nlist[i];
         auto x = linespace_mid(cfg.xl, cfg.xr, n, dx);
-        auto uh = std::vector<double>(n);
-
-        for (size_t j = 0; j < n; j++) {
-            double tmp = g.integrate([=](double s) {
-                return cfg.init(x[j] + s * dx / 2);
-            }) * dx / 2;
-            uh[j] = tmp / dx;
-        }
+        auto uh = cell_averages(cfg.init, x, dx, cfg.gauss_k);
 
         auto ex = Mesh1d{dx};
-        uh = solver.run(Vec{uh}, ex, 0, cfg.tend).value().data;
-
-        auto u = std::vector<double>(n);
-        for (size_t j = 0; j < n; j++) {
-            double tmp = g.integrate([=](double s) {
-                return exact(x[j] + s * dx / 2);
-            }) * dx / 2;
-            u[j] = tmp / dx;
-        }
-
-        error_l1[i] = error(uh, u, dx, ErrorType::L1);
-        error_l2[i] = error(uh, u, dx, ErrorType::L2);
-        error_linf[i] = error(uh, u, dx, ErrorType::Linf);
+        uh = cached_run(solver, Vec{uh}, ex, 0, cfg.tend, filename)
+              .value()
+              .data;
+
+        auto u = cell_averages(exact, x, dx, cfg.gauss_k);
+
+        auto errs = error_norms(uh, u, dx);
+        error_l1[i] = errs.l1;
+        error_l2[i] = errs.l2;
+        error_linf[i] = errs.linf;
     }
 
     auto order_l1 = order(error_l1, cfg.nlist);
@@ -1,14 +1,19 @@
 #pragma once
 
-#include <functional>
+#include <cmath>
 #include <vector>
 
 #include "burgers_exact.hpp"
 #include "constants.hpp"
+#include "flux_policy.hpp"
+#include "scalar_exact.hpp"
 
 using namespace flux;      // NOLINT
 using flux::constant::pi;  // NOLINT
 
+// init(x) and exact(x, t) are template parameters (deduced from the lambdas
+// of the *_config() functions), so projections and errors inline them
+template <typename Init, typename Exact>
 struct Config {
     double xl;
     double xr;
@@ -16,8 +21,8 @@ struct Config {
     size_t gauss_k;
     std::vector<size_t> nlist;
 
-    std::function<double(double)> init;
-    std::function<double(double, double)> exact;
+    Init init;
+    Exact exact;
 };
 
 inline auto plot_config() {
@@ -56,3 +61,34 @@ inline auto order_test_config() {
             },
     };
 }
+
+// other scalar laws, smooth solutions before the characteristics cross
+
+inline auto linear_advection_config() {
+    auto u0 = [](double x) { return std::sin(x); };
+    auto sol = ScalarExact<LinearAdvection<>>(u0, -pi, pi);
+    return Config{
+        .xl = -pi,
+        .xr = pi,
+        .tend = 1.0,
+        .gauss_k = 5,
+        .nlist = {10, 20, 40, 80, 160, 320, 640},
+        .init = u0,
+        .exact = [=](double x, double t) { return sol.eval(x, t); },
+    };
+}
+
+// breaking time about 0.74
+inline auto buckley_leverett_config() {
+    auto u0 = [](double x) { return 0.5 + 0.25 * std::sin(x); };
+    auto sol = ScalarExact<BuckleyLeverett<>>(u0, -pi, pi);
+    return Config{
+        .xl = -pi,
+        .xr = pi,
+        .tend = 0.4,
+        .gauss_k = 5,
+        .nlist = {10, 20, 40, 80, 160, 320, 640},
+        .init = u0,
+        .exact = [=](double x, double t) { return sol.eval(x, t); },
+    };
+}
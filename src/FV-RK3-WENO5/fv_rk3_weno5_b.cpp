@@ -0,0 +1,18 @@
+#include "fv_test.hpp"
+#include "schemes/fv_weno5.hpp"
+#include "solver/solver_blocked.hpp"
+
+using namespace flux;                   // NOLINT
+using flux::solver_blocked::RK3Solver;  // NOLINT
+
+int main() {
+    auto solver = RK3Solver<schemes::FVWENO5>{schemes::FVWENO5{}};
+    std::cout << "threads: " << solver.threads() << ", tile: " << solver.tile()
+              << '\n';
+
+    FV_order_test(order_test_config(), solver, OUTPUT_DIR "/order_b.csv");
+    FV_plot_test(plot_config(), solver,
+                 {OUTPUT_DIR "/plot_1_b.csv", OUTPUT_DIR "/plot_2_b.csv"});
+
+    return 0;
+}
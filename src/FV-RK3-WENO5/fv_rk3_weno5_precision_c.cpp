@@ -0,0 +1,42 @@
+#include "fv_test.hpp"
+#include "schemes/fv_weno5.hpp"
+#include "solver/solver_crtp.hpp"
+
+using namespace flux;                // NOLINT
+using flux::solver_crtp::RK3Solver;  // NOLINT
+
+// state in State, WENO weights and fluxes in Real
+template <typename State, typename Real>
+class PrecisionSolver
+    : public RK3Solver<BasicVec<State>, Mesh1d, PrecisionSolver<State, Real>> {
+public:
+    double get_dt(const BasicVec<State> &var, Mesh1d &ex, double t) const {
+        return m_scheme.get_dt(var, ex, t);
+    }
+
+    BasicVec<State> op_L(const BasicVec<State> &var, Mesh1d &ex,
+                         double t) const {
+        return m_scheme.op_L(var, ex, t);
+    }
+
+    auto cache_key() const { return std::tie(m_scheme); }
+
+private:
+    schemes::BasicFVWENO5<Burgers, State, Real> m_scheme{};
+};
+
+int main() {
+    std::cout << "double\n";
+    FV_order_test(order_test_config(), PrecisionSolver<double, double>{},
+                  OUTPUT_DIR "/order_double_c.csv");
+
+    std::cout << "mixed: double state, float WENO and flux\n";
+    FV_order_test(order_test_config(), PrecisionSolver<double, float>{},
+                  OUTPUT_DIR "/order_mixed_c.csv");
+
+    std::cout << "float\n";
+    FV_order_test<float>(order_test_config(), PrecisionSolver<float, float>{},
+                         OUTPUT_DIR "/order_float_c.csv");
+
+    return 0;
+}
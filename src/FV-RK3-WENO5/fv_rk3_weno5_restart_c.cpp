@@ -0,0 +1,64 @@
+#include <cstdio>
+#include <cstring>
+
+#include "fv_test.hpp"
+#include "schemes/fv_weno5.hpp"
+#include "solver/checkpoint.hpp"
+#include "solver/solver_crtp.hpp"
+
+using namespace flux;                // NOLINT
+using flux::solver_crtp::RK3Solver;  // NOLINT
+
+class FVWENO5Solver : public RK3Solver<Vec, Mesh1d, FVWENO5Solver> {
+public:
+    double get_dt(const Vec &var, Mesh1d &ex, double t) const {
+        return m_scheme.get_dt(var, ex, t);
+    }
+
+    Vec op_L(const Vec &var, Mesh1d &ex, double t) const {
+        return m_scheme.op_L(var, ex, t);
+    }
+
+private:
+    schemes::FVWENO5 m_scheme{};
+};
+
+// a run writing checkpoints dies halfway, is resumed from its last
+// checkpoint and must end bit-identical to a run that was never interrupted
+int main() {
+    auto cfg = order_test_config();
+    const size_t n = 320;
+    const auto ckpt = CheckpointConfig{OUTPUT_DIR "/restart.ckpt", 50};
+
+    double dx = 0;
+    auto x = linespace_mid(cfg.xl, cfg.xr, n, dx);
+    auto u0 = Vec{cell_averages(cfg.init, x, dx, cfg.gauss_k)};
+    auto ex = Mesh1d{dx};
+    auto solver = FVWENO5Solver{};
+
+    auto straight = solver.run(u0, ex, 0, cfg.tend);
+
+    // the interrupted run: only its checkpoint file is kept
+    auto died = solver.run(u0, ex, 0, cfg.tend / 2, ckpt);
+    auto last = load_checkpoint<Vec>(ckpt.path);
+    auto resumed = solver.run_from_checkpoint(ex, cfg.tend, ckpt);
+    std::remove(ckpt.path.c_str());
+
+    if (!straight || !died || !resumed || !last) {
+        std::cerr << "restart: a run failed\n";
+        exit(1);
+    }
+
+    const auto &a = straight.value().data;
+    const auto &b = resumed.value().data;
+    std::cout << "resumed at t = " << last.value().t << " after "
+              << last.value().iter << " iterations\n";
+    if (a.size() != b.size()
+        || std::memcmp(a.data(), b.data(), a.size() * sizeof(double)) != 0) {
+        std::cerr << "restart: the resumed run differs from the straight one\n";
+        exit(1);
+    }
+    std::cout << "bit-identical to the uninterrupted run\n";
+
+    return 0;
+}
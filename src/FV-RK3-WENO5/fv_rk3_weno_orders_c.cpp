@@ -0,0 +1,111 @@
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "fv_test.hpp"
+#include "schemes/fv_weno.hpp"
+#include "solver/solver_crtp.hpp"
+
+using namespace flux;                // NOLINT
+using flux::solver_crtp::RK3Solver;  // NOLINT
+
+// order 2R - 1, stencils and weights from weno_tables<R>
+template <size_t R>
+using Scheme = schemes::BasicFVWENO<R, Burgers>;
+
+template <size_t R>
+class OrderSolver : public RK3Solver<Vec, Mesh1d, OrderSolver<R>> {
+public:
+    double get_dt(const Vec &var, Mesh1d &ex, double t) const {
+        return m_scheme.get_dt(var, ex, t);
+    }
+
+    Vec op_L(const Vec &var, Mesh1d &ex, double t) const {
+        return m_scheme.op_L(var, ex, t);
+    }
+
+    auto cache_key() const { return std::tie(m_scheme); }
+
+private:
+    Scheme<R> m_scheme{};
+};
+
+inline volatile double op_L_sink = 0;  // keeps the timed op_L alive
+
+// ns per cell of one op_L on n cells
+template <size_t R>
+double op_L_cost(size_t n, size_t reps) {
+    auto u = std::vector<double>(n);
+    for (size_t i = 0; i < n; i++) {
+        u[i] = 0.5 + std::sin(2 * pi * static_cast<double>(i)
+                              / static_cast<double>(n));
+    }
+    auto var = Vec{u};
+    auto ex = Mesh1d{2 * pi / static_cast<double>(n)};
+    auto scheme = Scheme<R>{};
+
+    double best = 0;
+    for (size_t r = 0; r < reps; r++) {
+        auto start = std::chrono::steady_clock::now();
+        op_L_sink = scheme.op_L(var, ex, 0).data[n / 2];
+        auto stop = std::chrono::steady_clock::now();
+        double s = std::chrono::duration<double>(stop - start).count();
+        if (r == 0 || s < best) best = s;
+    }
+    return best / static_cast<double>(n) * 1e9;
+}
+
+int main() {
+    const char *names[] = {"WENO5", "WENO7", "WENO9"};
+    auto cfg = order_test_config();
+    // dt ~ dx^3 for WENO9, the finer grids take too long
+    cfg.nlist = {10, 20, 40, 80, 160};
+
+    std::vector<std::vector<double>> errors;
+    std::cout << "WENO5 (tables)\n";
+    errors.push_back(FV_order_test(cfg, OrderSolver<3>{},
+                                   OUTPUT_DIR "/order_weno5_c.csv"));
+    std::cout << "WENO7\n";
+    errors.push_back(FV_order_test(cfg, OrderSolver<4>{},
+                                   OUTPUT_DIR "/order_weno7_c.csv"));
+    std::cout << "WENO9\n";
+    errors.push_back(FV_order_test(cfg, OrderSolver<5>{},
+                                   OUTPUT_DIR "/order_weno9_c.csv"));
+
+    const size_t n_cost = 1 << 16;
+    const size_t reps = 20;
+    const double cost[] = {op_L_cost<3>(n_cost, reps),
+                           op_L_cost<4>(n_cost, reps),
+                           op_L_cost<5>(n_cost, reps)};
+
+    // cost per cell and L1 error at fixed resolutions
+    const char *filename = OUTPUT_DIR "/orders_c.csv";
+    std::fstream f(filename, std::ios::out);
+    if (f.fail()) {
+        std::cerr << "fail to open file " << filename << std::endl;
+        exit(1);
+    }
+    f << "scheme,op_L_ns_per_cell";
+    std::printf("%-8s %12s", "scheme", "op_L ns/cell");
+    for (auto n : cfg.nlist) {
+        f << ",error_1_n" << n;
+        std::printf(" %13s", ("n=" + std::to_string(n)).c_str());
+    }
+    f << '\n';
+    std::printf("\n");
+
+    for (size_t k = 0; k < std::size(names); k++) {
+        f << names[k] << ',' << cost[k];
+        std::printf("%-8s %12.2f", names[k], cost[k]);
+        for (auto e : errors[k]) {
+            f << ',' << e;
+            std::printf(" %13.2e", e);
+        }
+        f << '\n';
+        std::printf("\n");
+    }
+    std::cout << "export to file " << filename << '\n';
+
+    return 0;
+}
@@ -0,0 +1,189 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "config.hpp"
+#include "linespace.hpp"
+#include "projection.hpp"
+#include "schemes/fv_weno5.hpp"
+#include "solver/solver_crtp.hpp"
+
+
+using namespace flux;  // NOLINT
+
+// FV-WENO5 with an explicit RK of the tableau T at dt = T::ssp * cfl * dx /
+// max|f'(u)|, counting the op_L calls
+template <rk::RKTableau T>
+class SSPSolver
+    : public solver_crtp::RKSolver<T, Vec, Mesh1d, SSPSolver<T>> {
+public:
+    explicit SSPSolver(double cfl) : m_cfl(cfl) {}
+
+    double get_dt(const Vec &var, Mesh1d &ex, double t) const {
+        double df_max = m_scheme.max_speed(var.data, ex, 0, var.data.size());
+        return m_cfl * ex.dx / df_max;
+    }
+
+    Vec op_L(const Vec &var, Mesh1d &ex, double t) const {
+        m_calls++;
+        return m_scheme.op_L(var, ex, t);
+    }
+
+    size_t calls() const { return m_calls; }
+
+private:
+    schemes::FVWENO5 m_scheme;
+    double m_cfl;
+    mutable size_t m_calls{0};  // NOLINT
+};
+
+struct Method {
+    const char *name;
+    size_t stages;
+    size_t order;
+    double ssp;
+};
+
+template <rk::RKTableau T>
+Method method(const char *name) {
+    return {name, T::stages, T::order, T::ssp};
+}
+
+// cell averages of the initial data, dx is set
+template <typename Init, typename Exact>
+std::vector<double> initial(const Config<Init, Exact> &cfg, size_t n,
+                            double &dx) {
+    auto x = linespace_mid(cfg.xl, cfg.xr, n, dx);
+    return cell_averages(cfg.init, x, dx, cfg.gauss_k);
+}
+
+template <rk::RKTableau T, typename Init, typename Exact>
+std::vector<double> solve(const Config<Init, Exact> &cfg, size_t n, double cfl,
+                          size_t &calls) {
+    double dx = 0;
+    auto u0 = initial(cfg, n, dx);
+    auto ex = Mesh1d{dx};
+    auto solver = SSPSolver<T>{cfl};
+    auto u = solver.run(Vec{u0}, ex, 0, cfg.tend).value().data;
+    calls = solver.calls();
+    return u;
+}
+
+double l1_distance(const std::vector<double> &a, const std::vector<double> &b) {
+    double sum = 0;
+    for (size_t i = 0; i < a.size(); i++) sum += std::abs(a[i] - b[i]);
+    return sum / static_cast<double>(a.size());
+}
+
+// temporal order on the smooth problem: the spatial error is the same for
+// all cfl, so the distance to a reference with tiny steps is the RK error
+template <rk::RKTableau T, typename Init, typename Exact>
+std::vector<double> temporal_errors(const Config<Init, Exact> &cfg, size_t n,
+                                    const std::vector<double> &reference,
+                                    const std::vector<double> &cfls) {
+    auto errors = std::vector<double>{};
+    for (double cfl : cfls) {
+        size_t calls = 0;
+        errors.push_back(l1_distance(solve<T>(cfg, n, cfl / T::ssp, calls),
+                                     reference));
+    }
+    return errors;
+}
+
+// Largest cfl (step 0.05) after the shock has formed at which the solution
+// stays within the bounds of the initial data up to tol, the op_L calls per
+// unit time there. WENO is not TVD, so this is an empirical counterpart of
+// the SSP coefficient.
+template <rk::RKTableau T, typename Init, typename Exact>
+double largest_cfl(const Config<Init, Exact> &cfg, size_t n, double tol,
+                   double &rate) {
+    double dx = 0;
+    auto u0 = initial(cfg, n, dx);
+    auto [lo, hi] = std::minmax_element(u0.begin(), u0.end());
+    double best = 0;
+    for (size_t k = 1; k <= 200; k++) {
+        double cfl = 0.05 * static_cast<double>(k);
+        size_t calls = 0;
+        auto u = solve<T>(cfg, n, cfl / T::ssp, calls);
+        bool bounded = std::all_of(u.begin(), u.end(), [&](double v) {
+            return std::isfinite(v) && v <= *hi + tol && v >= *lo - tol;
+        });
+        if (!bounded) break;
+        best = cfl;
+        rate = static_cast<double>(calls) / cfg.tend;
+    }
+    return best;
+}
+
+int main() {
+    const auto methods = std::vector<Method>{
+        method<rk::SSPRK3>("SSPRK(3,3)"),
+        method<rk::SSPRK43>("SSPRK(4,3)"),
+        method<rk::SSPRK53>("SSPRK(5,3)"),
+        method<rk::SSPRK104>("SSPRK(10,4)"),
+    };
+
+    // temporal order, cfl = dt max|f'| / dx
+    auto smooth = order_test_config();
+    const size_t n_smooth = 200;
+    const auto cfls = std::vector<double>{0.8, 0.4, 0.2, 0.1};
+    size_t ref_calls = 0;
+    auto reference =
+        solve<rk::SSPRK104>(smooth, n_smooth, 0.01 / 6, ref_calls);
+    auto errors = std::vector<std::vector<double>>{
+        temporal_errors<rk::SSPRK3>(smooth, n_smooth, reference, cfls),
+        temporal_errors<rk::SSPRK43>(smooth, n_smooth, reference, cfls),
+        temporal_errors<rk::SSPRK53>(smooth, n_smooth, reference, cfls),
+        temporal_errors<rk::SSPRK104>(smooth, n_smooth, reference, cfls),
+    };
+
+    // bound preservation across the shock
+    auto shock = plot_config();
+    const size_t n_shock = 200;
+    const double tol = 1e-3;  // WENO5 alone overshoots by about 1e-4 here
+    auto rates = std::vector<double>(methods.size());
+    auto limits = std::vector<double>{
+        largest_cfl<rk::SSPRK3>(shock, n_shock, tol, rates[0]),
+        largest_cfl<rk::SSPRK43>(shock, n_shock, tol, rates[1]),
+        largest_cfl<rk::SSPRK53>(shock, n_shock, tol, rates[2]),
+        largest_cfl<rk::SSPRK104>(shock, n_shock, tol, rates[3]),
+    };
+
+    std::string filename = OUTPUT_DIR "/ssp_c.csv";
+    std::fstream f(filename, std::ios::out);
+    if (f.fail()) {
+        std::cerr << "fail to open file " << filename << std::endl;
+        exit(1);
+    }
+    f << "method,stages,order,ssp,ssp_per_stage";
+    for (double cfl : cfls) f << ",error_cfl_" << cfl;
+    f << ",temporal_order,largest_cfl,largest_cfl_per_stage,op_L_per_time\n";
+
+    std::printf("%12s %6s %5s %6s %8s %10s %10s %6s %8s %10s\n", "method",
+                "stages", "order", "ssp", "ssp/s", "e(0.8)", "e(0.1)",
+                "rate", "max_cfl", "op_L/time");
+    for (size_t m = 0; m < methods.size(); m++) {
+        const auto &mt = methods[m];
+        const auto &e = errors[m];
+        double rate = std::log2(e[e.size() - 2] / e.back());
+        double per_stage = mt.ssp / static_cast<double>(mt.stages);
+        std::printf("%12s %6zu %5zu %6.3f %8.3f %10.3e %10.3e %6.2f %8.2f "
+                    "%10.0f\n",
+                    mt.name, mt.stages, mt.order, mt.ssp, per_stage, e.front(),
+                    e.back(), rate, limits[m], rates[m]);
+
+        f << mt.name << ',' << mt.stages << ',' << mt.order << ',' << mt.ssp
+          << ',' << per_stage;
+        for (double v : e) f << ',' << v;
+        f << ',' << rate << ',' << limits[m] << ','
+          << limits[m] / static_cast<double>(mt.stages) << ',' << rates[m]
+          << '\n';
+    }
+    std::cout << "export to file " << filename << '\n';
+
+    return 0;
+}
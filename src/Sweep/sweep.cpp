@@ -0,0 +1,317 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "sweep.hpp"
+
+#include "burgers_exact.hpp"
+#include "error_and_order.hpp"
+#include "flux_policy.hpp"
+#include "linespace.hpp"
+#include "parallel/thread_team.hpp"
+#include "projection.hpp"
+#include "scalar_exact.hpp"
+#include "schemes/dg.hpp"
+#include "schemes/fd_weno5.hpp"
+#include "schemes/fv_godunov.hpp"
+#include "schemes/fv_weno.hpp"
+#include "schemes/fv_weno5.hpp"
+#include "solver/solver_crtp.hpp"
+
+using namespace flux;  // NOLINT
+using flux::constant::pi;
+
+template <typename Scheme>
+class SchemeSolver;
+
+// RK3 or forward Euler as the scheme asks
+template <typename Scheme>
+using SchemeSolverBase = std::conditional_t<
+    Scheme::rk3, solver_crtp::RK3Solver<Vec, Mesh1d, SchemeSolver<Scheme>>,
+    solver_crtp::EulerSolver<Vec, Mesh1d, SchemeSolver<Scheme>>>;
+
+template <typename Scheme>
+concept StageLimiter = requires(const Scheme &s, const Vec &v, Mesh1d &ex) {
+    s.post_process_rk_stage(v, ex, 0.0);
+};
+
+// the periodic get_dt, op_L and stage limiter of a scheme on the crtp
+// framework
+template <typename Scheme>
+class SchemeSolver : public SchemeSolverBase<Scheme> {
+public:
+    explicit SchemeSolver(Scheme scheme) : m_scheme(std::move(scheme)) {}
+
+    double get_dt(const Vec &var, Mesh1d &ex, double t) const {
+        return m_scheme.get_dt(var, ex, t);
+    }
+
+    Vec op_L(const Vec &var, Mesh1d &ex, double t) const {
+        return m_scheme.op_L(var, ex, t);
+    }
+
+    Vec post_process_rk_stage(const Vec &var, Mesh1d &ex, double t) const {
+        if constexpr (StageLimiter<Scheme>) {
+            return m_scheme.post_process_rk_stage(var, ex, t);
+        }
+        else {
+            return var;
+        }
+    }
+
+private:
+    Scheme m_scheme;
+};
+
+template <typename Scheme>
+Vec solve(const Job &job, Scheme scheme, Vec u0, double dx) {
+    auto solver = SchemeSolver<Scheme>{std::move(scheme)};
+    auto ex = Mesh1d{dx};
+    auto result = solver.run(std::move(u0), ex, 0, job.tend);
+    if (!result) {
+        std::cerr << job_key(job) << ": " << result.error() << std::endl;
+        return Vec{{std::numeric_limits<double>::quiet_NaN()}};
+    }
+    return result.value();
+}
+
+// errors of the cell averages (FV), point values (FD) or of the polynomials
+// at the Gauss points (DG), as in the order tests of the examples
+template <FluxPolicy F, typename Init, typename Exact>
+Result run_job(const Job &job, const Init &init, const Exact &exact_at) {
+    auto exact = [&](double s) { return exact_at(s, job.tend); };
+    double dx = 0;
+    auto x = linespace_mid(-pi, pi, job.n, dx);
+
+    auto start = std::chrono::steady_clock::now();
+    auto seconds = [&] {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now()
+                                             - start)
+            .count();
+    };
+
+    auto uh = std::vector<double>{};
+    auto u = std::vector<double>{};
+    if (job.scheme == "dg") {
+        auto scheme = schemes::BasicDG<F>(job.DG_k, job.gauss_k);
+        scheme.set_limiter(job.tvb_M);
+        auto v0 = modal_projection(init, x, dx, job.DG_k, job.gauss_k, 1);
+        start = std::chrono::steady_clock::now();
+        uh = solve(job, scheme, Vec{v0}, dx).data;
+        double time = seconds();
+        if (uh.size() != v0.size()) return {uh[0], uh[0], uh[0], time};
+
+        auto errs = modal_error_norms(uh, exact, x, dx, job.DG_k, job.gauss_k,
+                                      1);
+        return {errs.l1, errs.l2, errs.linf, time};
+    }
+
+    auto v0 = std::vector<double>(job.n);
+    double time = 0;
+    if (job.scheme == "fd_weno5") {
+        for (size_t j = 0; j < job.n; j++) v0[j] = init(x[j]);
+        start = std::chrono::steady_clock::now();
+        uh = solve(job, schemes::BasicFDWENO5<F>{}, Vec{v0}, dx).data;
+        time = seconds();
+        u = std::vector<double>(job.n);
+        for (size_t j = 0; j < job.n; j++) u[j] = exact(x[j]);
+    }
+    else {
+        v0 = cell_averages(init, x, dx, job.gauss_k, 1);
+        start = std::chrono::steady_clock::now();
+        if (job.scheme == "fv_godunov") {
+            uh = solve(job, schemes::BasicFVGodunov<F>{}, Vec{v0}, dx).data;
+        }
+        else if (job.scheme == "fv_weno5") {
+            uh = solve(job, schemes::BasicFVWENO5<F>{}, Vec{v0}, dx).data;
+        }
+        else if (job.scheme == "fv_weno7") {
+            uh = solve(job, schemes::BasicFVWENO<4, F>{}, Vec{v0}, dx).data;
+        }
+        else {
+            uh = solve(job, schemes::BasicFVWENO<5, F>{}, Vec{v0}, dx).data;
+        }
+        time = seconds();
+        u = cell_averages(exact, x, dx, job.gauss_k, 1);
+    }
+    if (uh.size() != u.size()) return {uh[0], uh[0], uh[0], time};
+
+    auto errs = error_norms(uh, u, dx, 1);
+    return {errs.l1, errs.l2, errs.linf, time};
+}
+
+// u0 = a + b sin(x) and the exact solution of the problem
+template <FluxPolicy F>
+Result run_job(const Job &job) {
+    double a = job.a;
+    double b = job.b;
+    auto u0 = [=](double x) { return a + b * std::sin(x); };
+    if constexpr (std::is_same_v<F, Burgers>) {
+        auto sol = BurgersExact(a, b, 1.0, 0, 1e-10);
+        return run_job<F>(job, u0,
+                          [&](double x, double t) { return sol.eval(x, t); });
+    }
+    else {
+        auto sol = ScalarExact<F>(u0, -pi, pi);
+        return run_job<F>(job, u0,
+                          [&](double x, double t) { return sol.eval(x, t); });
+    }
+}
+
+Result run_job(const Job &job) {
+    if (job.problem == "burgers") return run_job<Burgers>(job);
+    if (job.problem == "advection") return run_job<LinearAdvection<>>(job);
+    return run_job<BuckleyLeverett<>>(job);
+}
+
+// appends each row with a single write(2) on an O_APPEND descriptor, so
+// shards may share the table without interleaving their rows; the shard
+// that creates the file (O_EXCL) writes the header
+class Table {
+public:
+    explicit Table(const std::string &file) : m_file(file) {
+        m_fd = ::open(file.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_EXCL,
+                      0644);
+        bool fresh = m_fd >= 0;
+        if (!fresh && errno == EEXIST) {
+            m_fd = ::open(file.c_str(), O_WRONLY | O_APPEND);
+        }
+        if (m_fd < 0) {
+            std::cerr << "Table: fail to open file " << file << ": "
+                      << std::strerror(errno) << std::endl;
+            exit(1);
+        }
+
+        if (fresh) {
+            append(table_header() + '\n');
+        }
+        else if (!ends_with_newline(file)) {
+            append("\n");  // end a row cut short
+        }
+    }
+
+    Table(const Table &) = delete;
+
+    Table &operator=(const Table &) = delete;
+
+    ~Table() { ::close(m_fd); }
+
+    void append(const std::string &row) {
+        std::lock_guard lock(m_mutex);
+        auto written = ::write(m_fd, row.data(), row.size());
+        if (written < 0 || static_cast<size_t>(written) != row.size()) {
+            // a retry would split the row
+            std::cerr << "Table: fail to write file " << m_file << ": "
+                      << (written < 0 ? std::strerror(errno) : "short write")
+                      << std::endl;
+            exit(1);
+        }
+    }
+
+private:
+    static bool ends_with_newline(const std::string &file) {
+        std::ifstream f(file, std::ios::binary | std::ios::ate);
+        if (f.fail() || f.tellg() <= 0) return true;
+        f.seekg(-1, std::ios::end);
+        return f.get() == '\n';
+    }
+
+    std::string m_file;
+    int m_fd{-1};
+    std::mutex m_mutex;
+};
+
+[[noreturn]] void usage(const char *name) {
+    std::cerr << "usage: " << name
+              << " [spec] [table] [--threads T] [--shard k/N]\n"
+                 "  spec   sweep specification (default " SWEEP_SPEC ")\n"
+                 "  table  aggregated results, resumed if it exists\n"
+                 "         (default " OUTPUT_DIR "/sweep.csv)\n"
+                 "  T      worker threads (default FLUX_NUM_THREADS or all "
+                 "cores)\n"
+                 "  k/N    run every N-th job from the k-th (0 <= k < N) for "
+                 "N processes\n";
+    exit(1);
+}
+
+int main(int argc, char **argv) {
+    std::string spec = SWEEP_SPEC;
+    std::string table = OUTPUT_DIR "/sweep.csv";
+    size_t threads = parallel::default_thread_count();
+    size_t shard = 0;
+    size_t shards = 1;
+
+    size_t positional = 0;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) {
+            threads = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--shard" && i + 1 < argc) {
+            if (std::sscanf(argv[++i], "%zu/%zu", &shard, &shards) != 2) {
+                usage(argv[0]);
+            }
+        }
+        else if (!arg.empty() && arg[0] != '-' && positional < 2) {
+            (positional++ == 0 ? spec : table) = arg;
+        }
+        else {
+            usage(argv[0]);
+        }
+    }
+    if (threads == 0 || shards == 0 || shard >= shards) usage(argv[0]);
+
+    // longest first, so the short jobs fill the gaps at the end; the shards
+    // deal the sorted list round robin and get similar totals
+    auto jobs = read_spec(spec);
+    std::stable_sort(jobs.begin(), jobs.end(), [](const Job &l, const Job &r) {
+        return job_cost(l) > job_cost(r);
+    });
+    auto done = read_done(table);
+    auto todo = std::vector<Job>{};
+    for (size_t i = shard; i < jobs.size(); i += shards) {
+        if (!done.contains(job_key(jobs[i]))) todo.push_back(jobs[i]);
+    }
+    std::cout << "sweep " << spec << ": " << jobs.size() << " jobs, "
+              << todo.size() << " to run on " << threads << " threads\n";
+
+    auto out = Table(table);
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> finished{0};
+    std::mutex print_mutex;
+    auto worker = [&] {
+        for (size_t i = next++; i < todo.size(); i = next++) {
+            auto result = run_job(todo[i]);
+            out.append(table_row(todo[i], result));
+
+            std::lock_guard lock(print_mutex);
+            std::printf("[%zu/%zu] %s  %.4e  %.3fs\n", ++finished, todo.size(),
+                        job_key(todo[i]).c_str(), result.error_l1,
+                        result.seconds);
+        }
+    };
+    {
+        auto pool = std::vector<std::jthread>{};
+        for (size_t t = 0; t < std::min(threads, todo.size()); t++) {
+            pool.emplace_back(worker);
+        }
+    }
+    std::cout << "export to file " << table << '\n';
+
+    return 0;
+}
@@ -0,0 +1,302 @@
+#pragma once
+
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "constants.hpp"
+
+// One run of a scalar 1d scheme on u0(x) = a + b sin(x), x in [-pi, pi].
+// Keys a scheme does not use keep their defaults (DG_k = 0, tvb_M = -1 for
+// the FV and FD schemes), so equal runs have equal keys.
+struct Job {
+    std::string scheme;
+    std::string problem;
+    double a;
+    double b;
+    size_t n;
+    double tend;
+    size_t gauss_k;
+    size_t DG_k;
+    double tvb_M;
+};
+
+struct Result {
+    double error_l1;
+    double error_l2;
+    double error_linf;
+    double seconds;
+};
+
+inline const std::vector<std::string> &job_columns() {
+    static const std::vector<std::string> columns = {
+        "scheme", "problem", "a", "b", "n", "tend", "gauss_k", "DG_k", "tvb_M"};
+    return columns;
+}
+
+// shortest representation that reads back to v
+inline std::string format_double(double v) {
+    char buf[32];
+    auto [end, ec] = std::to_chars(buf, buf + sizeof(buf), v);
+    return {buf, end};
+}
+
+// the key columns of the table
+inline std::string job_key(const Job &job) {
+    return job.scheme + ',' + job.problem + ',' + format_double(job.a) + ','
+           + format_double(job.b) + ',' + std::to_string(job.n) + ','
+           + format_double(job.tend) + ',' + std::to_string(job.gauss_k) + ','
+           + std::to_string(job.DG_k) + ',' + format_double(job.tvb_M);
+}
+
+// Relative cost: cells times steps times work per cell and step, with the dt
+// of the schemes (dx^{5/3} for WENO5, dx^{(k+1)/3} for DG_k > 2).
+inline double job_cost(const Job &job) {
+    auto n = static_cast<double>(job.n);
+    double dx = 2 * flux::constant::pi / n;
+    double dt = dx;
+    double work = 1;
+    if (job.scheme == "fv_godunov") {
+        dt = 0.5 * dx;
+    }
+    else if (job.scheme == "fv_weno5" || job.scheme == "fd_weno5") {
+        dt = std::pow(dx, 5.0 / 3) / 2;
+        work = 3 * 5;
+    }
+    else if (job.scheme == "fv_weno7") {
+        dt = std::pow(dx, 7.0 / 3) / 2;
+        work = 3 * 7;
+    }
+    else if (job.scheme == "fv_weno9") {
+        dt = std::pow(dx, 9.0 / 3) / 2;
+        work = 3 * 9;
+    }
+    else if (job.scheme == "dg") {
+        auto k = static_cast<double>(job.DG_k);
+        dt = (job.DG_k > 2 ? std::pow(dx, (k + 1) / 3) : dx) / (2 * k + 1);
+        work = 3 * (k + 1) * static_cast<double>(job.gauss_k);
+    }
+    return n * job.tend / dt * work;
+}
+
+namespace detail {
+
+inline std::string trim(const std::string &s) {
+    auto first = s.find_first_not_of(" \t\r");
+    if (first == std::string::npos) return {};
+    auto last = s.find_last_not_of(" \t\r");
+    return s.substr(first, last - first + 1);
+}
+
+inline std::vector<std::string> split(const std::string &s, char delimiter) {
+    auto result = std::vector<std::string>{};
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, delimiter)) result.push_back(trim(item));
+    return result;
+}
+
+[[noreturn]] inline void spec_error(const std::string &file, size_t line,
+                                    const std::string &msg) {
+    std::cerr << file << ':' << line << ": " << msg << std::endl;
+    exit(1);
+}
+
+// u0 = a + b sin(x) of the examples' configs
+inline void problem_defaults(const std::string &problem, double &a,
+                             double &b) {
+    if (problem == "burgers") {
+        a = 0.5;
+        b = 1;
+    }
+    else if (problem == "advection") {
+        a = 0;
+        b = 1;
+    }
+    else {
+        a = 0.5;
+        b = 0.25;
+    }
+}
+
+using Block = std::map<std::string, std::vector<std::string>>;
+
+inline double to_double(const std::string &file, size_t line,
+                        const std::string &s) {
+    size_t pos = 0;
+    double v = 0;
+    try {
+        v = std::stod(s, &pos);
+    }
+    catch (const std::exception &) {
+        pos = 0;
+    }
+    if (s.empty() || pos != s.size()) spec_error(file, line, "bad number " + s);
+    return v;
+}
+
+inline size_t to_size(const std::string &file, size_t line,
+                      const std::string &s) {
+    double v = to_double(file, line, s);
+    if (v < 0 || v != std::floor(v)) spec_error(file, line, "bad count " + s);
+    return static_cast<size_t>(v);
+}
+
+// cartesian product of one block, in the order of its keys
+inline void expand(const std::string &file, size_t line, const Block &block,
+                   std::vector<Job> &jobs, std::set<std::string> &keys) {
+    static const std::set<std::string> schemes = {
+        "fv_godunov", "fv_weno5", "fv_weno7", "fv_weno9", "fd_weno5", "dg"};
+    static const std::set<std::string> problems = {"burgers", "advection",
+                                                   "buckley_leverett"};
+    for (const auto *required : {"scheme", "problem", "n", "tend"}) {
+        if (!block.contains(required)) {
+            spec_error(file, line, std::string{"block without "} + required);
+        }
+    }
+
+    auto names = std::vector<std::string>{};
+    auto values = std::vector<std::vector<std::string>>{};
+    for (const auto &[name, list] : block) {
+        names.push_back(name);
+        values.push_back(list);
+    }
+
+    auto index = std::vector<size_t>(names.size());
+    while (true) {
+        auto get = [&](const std::string &name) -> const std::string * {
+            for (size_t i = 0; i < names.size(); i++) {
+                if (names[i] == name) return &values[i][index[i]];
+            }
+            return nullptr;
+        };
+
+        auto job = Job{*get("scheme"), *get("problem"), 0, 0, 0, 0, 5, 0, -1};
+        if (!schemes.contains(job.scheme)) {
+            spec_error(file, line, "unknown scheme " + job.scheme);
+        }
+        if (!problems.contains(job.problem)) {
+            spec_error(file, line, "unknown problem " + job.problem);
+        }
+        problem_defaults(job.problem, job.a, job.b);
+        if (const auto *v = get("a")) job.a = to_double(file, line, *v);
+        if (const auto *v = get("b")) job.b = to_double(file, line, *v);
+        job.n = to_size(file, line, *get("n"));
+        job.tend = to_double(file, line, *get("tend"));
+        if (const auto *v = get("gauss_k")) {
+            job.gauss_k = to_size(file, line, *v);
+        }
+        if (job.scheme == "dg") {
+            job.DG_k = 2;
+            if (const auto *v = get("DG_k")) job.DG_k = to_size(file, line, *v);
+            if (const auto *v = get("tvb_M")) {
+                job.tvb_M = to_double(file, line, *v);
+            }
+        }
+        if (job.n < 5 || job.gauss_k == 0 || job.tend < 0) {
+            spec_error(file, line, "bad job " + job_key(job));
+        }
+        if (keys.insert(job_key(job)).second) jobs.push_back(job);
+
+        size_t i = 0;
+        for (; i < names.size(); i++) {
+            if (++index[i] < values[i].size()) break;
+            index[i] = 0;
+        }
+        if (i == names.size()) break;
+    }
+}
+
+}  // namespace detail
+
+// Sweep specification: blocks started by a "[name]" line, each the cartesian
+// product of its "key = v1, v2, ..." lines; '#' starts a comment. Duplicate
+// jobs are dropped.
+inline std::vector<Job> read_spec(const std::string &file) {
+    const auto &columns = job_columns();
+    const auto known = std::set<std::string>(columns.begin(), columns.end());
+
+    std::ifstream f(file);
+    if (f.fail()) {
+        std::cerr << "read_spec: fail to open file " << file << std::endl;
+        exit(1);
+    }
+
+    auto jobs = std::vector<Job>{};
+    auto keys = std::set<std::string>{};
+    auto block = detail::Block{};
+    size_t block_line = 0;
+    size_t line_no = 0;
+    std::string line;
+    while (std::getline(f, line)) {
+        line_no++;
+        line = detail::trim(line.substr(0, line.find('#')));
+        if (line.empty()) continue;
+
+        if (line.front() == '[') {
+            if (!block.empty()) {
+                detail::expand(file, block_line, block, jobs, keys);
+            }
+            block.clear();
+            block_line = line_no;
+            continue;
+        }
+
+        auto eq = line.find('=');
+        if (eq == std::string::npos) {
+            detail::spec_error(file, line_no, "expected key = values");
+        }
+        auto key = detail::trim(line.substr(0, eq));
+        auto list = detail::split(line.substr(eq + 1), ',');
+        if (!known.contains(key)) {
+            detail::spec_error(file, line_no, "unknown key " + key);
+        }
+        if (list.empty() || list.back().empty()) {
+            detail::spec_error(file, line_no, "no values for " + key);
+        }
+        block[key] = list;
+    }
+    if (!block.empty()) detail::expand(file, block_line, block, jobs, keys);
+    return jobs;
+}
+
+inline std::string table_header() {
+    std::string header;
+    for (const auto &c : job_columns()) header += c + ',';
+    return header + "error_1,error_2,error_inf,seconds";
+}
+
+// keys of the complete rows of an existing table; a line cut short by an
+// interrupted run and repeated headers are skipped
+inline std::set<std::string> read_done(const std::string &file) {
+    auto done = std::set<std::string>{};
+    std::ifstream f(file);
+    if (f.fail()) return done;
+
+    const size_t key_columns = job_columns().size();
+    const size_t columns = key_columns + 4;
+    std::string line;
+    while (std::getline(f, line)) {
+        if (f.eof()) break;  // no newline, the write did not finish
+        auto fields = detail::split(line, ',');
+        if (fields.size() != columns || fields[0] == "scheme") continue;
+
+        std::string key = fields[0];
+        for (size_t i = 1; i < key_columns; i++) key += ',' + fields[i];
+        done.insert(key);
+    }
+    return done;
+}
+
+inline std::string table_row(const Job &job, const Result &result) {
+    return job_key(job) + ',' + format_double(result.error_l1) + ','
+           + format_double(result.error_l2) + ','
+           + format_double(result.error_linf) + ','
+           + format_double(result.seconds) + '\n';
+}
@@ -0,0 +1,43 @@
+# Sweep of the scalar 1d schemes, run by example_sweep.
+#
+# Each [block] runs the cartesian product of its keys, a key takes a comma
+# separated list. Keys a scheme does not use are ignored.
+#
+#   scheme   fv_godunov, fv_weno5, fv_weno7, fv_weno9, fd_weno5, dg
+#   problem  burgers, advection, buckley_leverett with u0 = a + b sin(x)
+#            on [-pi, pi]
+#   a, b     defaults 0.5, 1 (burgers), 0, 1 (advection), 0.5, 0.25
+#            (buckley_leverett)
+#   n        cells
+#   tend     final time
+#   gauss_k  Gauss points of projection and errors, default 5
+#   DG_k     degree of dg, default 2
+#   tvb_M    TVB constant of the dg limiter, negative (default) disables it
+
+[fv and fd on the smooth solutions]
+scheme = fv_godunov, fv_weno5, fd_weno5
+problem = burgers, advection, buckley_leverett
+n = 10, 20, 40, 80, 160, 320, 640
+tend = 0.4
+
+[higher order fv]
+scheme = fv_weno7, fv_weno9
+problem = advection
+n = 10, 20, 40, 80, 160
+tend = 1
+
+[burgers amplitudes]
+scheme = fv_weno5
+problem = burgers
+b = 0.25, 0.5, 1
+n = 40, 80, 160, 320
+tend = 0.5, 1.5
+
+[dg degrees and limiter]
+scheme = dg
+problem = burgers
+DG_k = 1, 2, 3
+gauss_k = 7
+tvb_M = -1, 0, 1
+n = 10, 20, 40, 80, 160, 320
+tend = 0.5, 1.5